@@ -0,0 +1,428 @@
+#pragma once
+
+#include <fields_count.h>
+#include <for_each.h>
+#include <soa_vector.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// the aggregate kernels over the numeric column, e.g., the span returned by
+// SoaVector<T>::Column<I>(), or the I-th field of the rows in std::vector<T>.
+// the contiguous columns of double, float, int32_t and int64_t are summarized
+// by avx2 if it's enabled, e.g., -mavx2 or -march=native, otherwise by sse2
+// for floats, and the rest are summarized by the scalar loop
+namespace reflpp {
+
+struct AggregateOptions {
+    // the number of threads, including the caller thread
+    std::size_t threads = 1;
+
+    // the column is split only if every chunk gets at least so many elements.
+    // notes, the kernels reduce the small chunk faster than std::async starts
+    // the thread for it
+    std::size_t min_chunk_size = 1 << 16;
+};
+
+namespace _ {
+
+template <typename T>
+using SumType = std::conditional_t<
+    IsFloat<T>, double,
+    std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+}  // namespace _
+
+// notes, the integers are summed as 64-bit integers, which may wrap around,
+// and the floats are summed as double. NaNs are ignored by min and max
+template <typename T>
+struct Stats {
+    std::size_t count{0};
+    _::SumType<T> sum{0};
+    T min{0};
+    T max{0};
+
+    double mean() const {
+        return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+    }
+};
+
+namespace _ {
+
+// notes, the integers are added as unsigned, which wraps around instead of
+// the undefined overflow
+template <typename S, typename T>
+inline void AddTo(S& sum, T v) {
+    if constexpr (std::is_floating_point_v<S>) {
+        sum += v;
+    } else {
+        sum = static_cast<S>(static_cast<std::uint64_t>(sum) +
+                             static_cast<std::uint64_t>(v));
+    }
+}
+
+template <typename T>
+inline constexpr bool IsColumnValue = IsNumeric<T> && sizeof(T) <= 8;
+
+template <typename C, typename = void>
+struct IsNumericColumnImpl : std::false_type {};
+
+template <typename C>
+struct IsNumericColumnImpl<
+    C, std::enable_if_t<std::ranges::contiguous_range<const C&>>>
+    : std::bool_constant<
+          IsColumnValue<std::ranges::range_value_t<const C&>>> {};
+
+template <typename C>
+inline constexpr bool IsNumericColumn = IsNumericColumnImpl<C>::value;
+
+// the running min and max start from the extremes, so that the NaNs are
+// skipped by the comparisons
+template <typename T>
+struct Accumulator {
+    SumType<T> sum{0};
+    T min = IsFloat<T> ? std::numeric_limits<T>::infinity()
+                       : std::numeric_limits<T>::max();
+    T max = IsFloat<T> ? -std::numeric_limits<T>::infinity()
+                       : std::numeric_limits<T>::lowest();
+    std::size_t count{0};
+
+    void Add(T v) {
+        AddTo(sum, v);
+        min = v < min ? v : min;
+        max = v > max ? v : max;
+    }
+
+    void Merge(const Accumulator& other) {
+        AddTo(sum, other.sum);
+        min = other.min < min ? other.min : min;
+        max = other.max > max ? other.max : max;
+        count += other.count;
+    }
+
+    Stats<T> ToStats() const {
+        Stats<T> st;
+        st.count = count;
+        st.sum = sum;
+        if (count > 0) {
+            st.min = min;
+            st.max = max;
+        }
+        return st;
+    }
+};
+
+#if defined(__AVX2__)
+
+template <typename T>
+inline constexpr bool HasSimdKernel =
+    std::is_same_v<T, double> || std::is_same_v<T, float> ||
+    std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t>;
+
+inline void ReduceLanes(__m256d sum, __m256d lo, __m256d hi,
+                        Accumulator<double>& acc) {
+    alignas(32) double s[4], l[4], h[4];
+    _mm256_store_pd(s, sum);
+    _mm256_store_pd(l, lo);
+    _mm256_store_pd(h, hi);
+    for (int i = 0; i < 4; ++i) {
+        acc.sum += s[i];
+        acc.min = l[i] < acc.min ? l[i] : acc.min;
+        acc.max = h[i] > acc.max ? h[i] : acc.max;
+    }
+}
+
+// notes, the floats are widened to double, which is exact
+template <typename T>
+inline std::size_t SummarizeSimd(const T* p, std::size_t n,
+                                 Accumulator<T>& acc) {
+    std::size_t i = 0;
+    if constexpr (IsFloat<T>) {
+        __m256d sum = _mm256_setzero_pd();
+        __m256d lo = _mm256_set1_pd(acc.min);
+        __m256d hi = _mm256_set1_pd(acc.max);
+        for (; i + 4 <= n; i += 4) {
+            __m256d v;
+            if constexpr (std::is_same_v<T, float>) {
+                v = _mm256_cvtps_pd(_mm_loadu_ps(p + i));
+            } else {
+                v = _mm256_loadu_pd(p + i);
+            }
+            sum = _mm256_add_pd(sum, v);
+            lo = _mm256_min_pd(v, lo);
+            hi = _mm256_max_pd(v, hi);
+        }
+
+        Accumulator<double> wide;
+        ReduceLanes(sum, lo, hi, wide);
+        acc.sum += wide.sum;
+        acc.min = static_cast<T>(wide.min);
+        acc.max = static_cast<T>(wide.max);
+    } else if constexpr (sizeof(T) == 4) {
+        __m256i sum = _mm256_setzero_si256();
+        __m256i lo = _mm256_set1_epi32(acc.min);
+        __m256i hi = _mm256_set1_epi32(acc.max);
+        for (; i + 8 <= n; i += 8) {
+            auto v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(p + i));
+            lo = _mm256_min_epi32(lo, v);
+            hi = _mm256_max_epi32(hi, v);
+            sum = _mm256_add_epi64(
+                sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            sum = _mm256_add_epi64(
+                sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+
+        alignas(32) std::int64_t s[4];
+        alignas(32) std::int32_t l[8], h[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s), sum);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(l), lo);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(h), hi);
+        for (int k = 0; k < 4; ++k) AddTo(acc.sum, s[k]);
+        acc.min = *std::min_element(l, l + 8);
+        acc.max = *std::max_element(h, h + 8);
+    } else {
+        __m256i sum = _mm256_setzero_si256();
+        __m256i lo = _mm256_set1_epi64x(acc.min);
+        __m256i hi = _mm256_set1_epi64x(acc.max);
+        for (; i + 4 <= n; i += 4) {
+            auto v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(p + i));
+            sum = _mm256_add_epi64(sum, v);
+            lo = _mm256_blendv_epi8(lo, v, _mm256_cmpgt_epi64(lo, v));
+            hi = _mm256_blendv_epi8(hi, v, _mm256_cmpgt_epi64(v, hi));
+        }
+
+        alignas(32) std::int64_t s[4], l[4], h[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s), sum);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(l), lo);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(h), hi);
+        for (int k = 0; k < 4; ++k) {
+            AddTo(acc.sum, s[k]);
+            acc.min = std::min(acc.min, static_cast<T>(l[k]));
+            acc.max = std::max(acc.max, static_cast<T>(h[k]));
+        }
+    }
+    return i;
+}
+
+#elif defined(__SSE2__)
+
+template <typename T>
+inline constexpr bool HasSimdKernel =
+    std::is_same_v<T, double> || std::is_same_v<T, float>;
+
+template <typename T>
+inline std::size_t SummarizeSimd(const T* p, std::size_t n,
+                                 Accumulator<T>& acc) {
+    __m128d sum = _mm_setzero_pd();
+    __m128d lo = _mm_set1_pd(acc.min);
+    __m128d hi = _mm_set1_pd(acc.max);
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v;
+        if constexpr (std::is_same_v<T, float>) {
+            v = _mm_cvtps_pd(_mm_castsi128_ps(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + i))));
+        } else {
+            v = _mm_loadu_pd(p + i);
+        }
+        sum = _mm_add_pd(sum, v);
+        lo = _mm_min_pd(v, lo);
+        hi = _mm_max_pd(v, hi);
+    }
+
+    alignas(16) double s[2], l[2], h[2];
+    _mm_store_pd(s, sum);
+    _mm_store_pd(l, lo);
+    _mm_store_pd(h, hi);
+    acc.sum += s[0] + s[1];
+    acc.min = static_cast<T>(l[0] < l[1] ? l[0] : l[1]);
+    acc.max = static_cast<T>(h[0] > h[1] ? h[0] : h[1]);
+    return i;
+}
+
+#else
+
+template <typename T>
+inline constexpr bool HasSimdKernel = false;
+
+template <typename T>
+inline std::size_t SummarizeSimd(const T*, std::size_t, Accumulator<T>&) {
+    return 0;
+}
+
+#endif
+
+template <typename T>
+Accumulator<T> SummarizeColumn(const T* p, std::size_t n) {
+    Accumulator<T> acc;
+    acc.count = n;
+
+    std::size_t i = 0;
+    if constexpr (HasSimdKernel<T>) {
+        i = SummarizeSimd(p, n, acc);
+    }
+    for (; i < n; ++i) {
+        acc.Add(p[i]);
+    }
+    return acc;
+}
+
+// splits [0, n) into chunks, and reduces them by multiple threads. notes, the
+// first chunk is reduced by the caller thread
+template <typename R, typename F, typename M>
+R ParallelReduce(std::size_t n, const AggregateOptions& opts, F&& reduce,
+                 M&& merge) {
+    const std::size_t chunks = std::min(
+        opts.threads, n / std::max<std::size_t>(1, opts.min_chunk_size));
+
+    if (chunks < 2) {
+        return reduce(0, n);
+    }
+
+    std::vector<std::future<R>> futures;
+    futures.reserve(chunks - 1);
+    for (std::size_t i = 1; i < chunks; ++i) {
+        futures.emplace_back(std::async(std::launch::async, reduce,
+                                        n * i / chunks, n * (i + 1) / chunks));
+    }
+
+    R result = reduce(0, n / chunks);
+    for (auto& future : futures) {
+        merge(result, future.get());
+    }
+    return result;
+}
+
+template <typename T>
+struct Binning {
+    double lo;
+    double hi;
+    std::size_t bins;
+
+    // the values out of [lo, hi) and NaNs are skipped
+    void Add(T v, std::vector<std::size_t>& counts) const {
+        auto x = static_cast<double>(v);
+        if (!(x >= lo && x < hi)) return;
+
+        auto idx = static_cast<std::size_t>((x - lo) / (hi - lo) * bins);
+        ++counts[std::min(idx, bins - 1)];
+    }
+};
+
+template <typename T, typename Get>
+std::vector<std::size_t> BuildHistogram(std::size_t n, const Get& get,
+                                        double lo, double hi, std::size_t bins,
+                                        const AggregateOptions& opts) {
+    if (bins == 0 || !(lo < hi)) {
+        return std::vector<std::size_t>(bins);
+    }
+
+    Binning<T> binning{lo, hi, bins};
+    return ParallelReduce<std::vector<std::size_t>>(
+        n, opts,
+        [&get, &binning](std::size_t first, std::size_t last) {
+            std::vector<std::size_t> counts(binning.bins);
+            for (std::size_t i = first; i < last; ++i) {
+                binning.Add(get(i), counts);
+            }
+            return counts;
+        },
+        [](std::vector<std::size_t>& a, const std::vector<std::size_t>& b) {
+            for (std::size_t i = 0; i < a.size(); ++i) a[i] += b[i];
+        });
+}
+
+}  // namespace _
+
+// summarizes the contiguous column, e.g., std::vector<double> or std::span
+template <typename C, std::enable_if_t<_::IsNumericColumn<C>, int> = 0>
+auto Aggregate(const C& column, const AggregateOptions& opts = {}) {
+    using T = std::ranges::range_value_t<const C&>;
+
+    const T* p = std::ranges::data(column);
+    auto acc = _::ParallelReduce<_::Accumulator<T>>(
+        std::ranges::size(column), opts,
+        [p](std::size_t first, std::size_t last) {
+            return _::SummarizeColumn(p + first, last - first);
+        },
+        [](auto& a, const auto& b) { a.Merge(b); });
+    return acc.ToStats();
+}
+
+// summarizes the I-th field of the rows
+template <std::size_t I, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+auto Aggregate(const std::vector<T>& rows, const AggregateOptions& opts = {}) {
+    using V = std::remove_const_t<FieldType<I, T>>;
+    static_assert(_::IsColumnValue<V>, "Only the numeric field is supported");
+
+    auto acc = _::ParallelReduce<_::Accumulator<V>>(
+        rows.size(), opts,
+        [&rows](std::size_t first, std::size_t last) {
+            _::Accumulator<V> acc;
+            acc.count = last - first;
+            for (std::size_t i = first; i < last; ++i) {
+                acc.Add(GetField<I>(rows[i]));
+            }
+            return acc;
+        },
+        [](auto& a, const auto& b) { a.Merge(b); });
+    return acc.ToStats();
+}
+
+template <std::size_t I, typename T>
+auto Aggregate(const SoaVector<T>& rows, const AggregateOptions& opts = {}) {
+    return Aggregate(rows.template Column<I>(), opts);
+}
+
+// counts the values in the equal-width bins of [lo, hi)
+template <typename C, std::enable_if_t<_::IsNumericColumn<C>, int> = 0>
+std::vector<std::size_t> Histogram(const C& column, double lo, double hi,
+                                   std::size_t bins,
+                                   const AggregateOptions& opts = {}) {
+    using T = std::ranges::range_value_t<const C&>;
+
+    const T* p = std::ranges::data(column);
+    return _::BuildHistogram<T>(
+        std::ranges::size(column), [p](std::size_t i) { return p[i]; }, lo,
+        hi, bins, opts);
+}
+
+template <std::size_t I, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+std::vector<std::size_t> Histogram(const std::vector<T>& rows, double lo,
+                                   double hi, std::size_t bins,
+                                   const AggregateOptions& opts = {}) {
+    using V = std::remove_const_t<FieldType<I, T>>;
+    static_assert(_::IsColumnValue<V>, "Only the numeric field is supported");
+
+    return _::BuildHistogram<V>(
+        rows.size(), [&rows](std::size_t i) { return GetField<I>(rows[i]); },
+        lo, hi, bins, opts);
+}
+
+template <std::size_t I, typename T>
+std::vector<std::size_t> Histogram(const SoaVector<T>& rows, double lo,
+                                   double hi, std::size_t bins,
+                                   const AggregateOptions& opts = {}) {
+    return Histogram(rows.template Column<I>(), lo, hi, bins, opts);
+}
+
+}  // namespace reflpp
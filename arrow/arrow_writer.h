@@ -0,0 +1,530 @@
+#pragma once
+
+#include <byte_order.h>
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// the rows of the flat struct are written as the arrow record batch, each
+// field is a column:
+//   - bool is the bit-packed Bool
+//   - integers, chars and enums are Int of the same width and signedness
+//   - float and double are FloatingPoint
+//   - strings are LargeUtf8, whose offsets are 64-bit
+//   - the optional of the above is nullable, which has the validity bitmap
+// the columns are wrapped with the flatbuffers metadata of the arrow ipc
+// format, either the streaming format or the file format, i.e., feather v2.
+// notes, the buffers are 8-byte aligned and little-endian
+namespace reflpp {
+namespace arrow {
+
+namespace _ {
+
+inline constexpr std::size_t kAlignment = 8;
+
+// see Schema.fbs and Message.fbs of arrow
+inline constexpr std::int16_t kMetadataV5 = 4;
+
+enum MessageHeader : std::uint8_t {
+    kHeaderSchema = 1,
+    kHeaderRecordBatch = 3,
+};
+
+enum TypeId : std::uint8_t {
+    kTypeInt = 2,
+    kTypeFloatingPoint = 3,
+    kTypeBool = 6,
+    kTypeLargeUtf8 = 20,
+};
+
+enum Precision : std::int16_t {
+    kPrecisionSingle = 1,
+    kPrecisionDouble = 2,
+};
+
+template <typename T>
+inline constexpr bool IsFixedWidth =
+    IsNumeric<T> || IsChar<T> || IsEnum<T>;
+
+template <typename T>
+consteval bool IsColumnType() {
+    if constexpr (IsStringLike<T>) {
+        return sizeof(typename T::value_type) == 1;
+    } else {
+        return IsBool<T> || (IsFixedWidth<T> && sizeof(T) <= 8);
+    }
+}
+
+template <typename T, typename = void>
+struct IntegerOfImpl {
+    using type = T;
+};
+
+template <typename T>
+struct IntegerOfImpl<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using type = std::underlying_type_t<T>;
+};
+
+template <typename T>
+using IntegerOf = typename IntegerOfImpl<T>::type;
+
+// the minimal flatbuffers builder. notes, the objects are written front to
+// back, i.e., the parent goes first, and the offset to the child is patched
+// once the child is written, so that all of offsets point forward
+class FlatBuilder {
+   public:
+    struct Field {
+        std::uint16_t slot;
+        std::uint8_t size;
+        std::uint64_t value;
+    };
+
+    // the field whose value is the offset to be patched
+    static Field Offset(std::uint16_t slot) { return {slot, 4, 0}; }
+
+    template <typename T>
+    static Field Scalar(std::uint16_t slot, T v) {
+        using U = UnsignedOfSize<T>;
+        return {slot, sizeof(T), static_cast<std::uint64_t>(static_cast<U>(v))};
+    }
+
+    // the table, and the positions of its fields by slot
+    struct Table {
+        std::size_t pos;
+        std::array<std::size_t, 8> fields;
+    };
+
+    FlatBuilder() { buf_.resize(4); }
+
+    void Finish(std::size_t root) { Patch(0, root); }
+
+    const std::string& data() const { return buf_; }
+
+    // the vtable is placed just ahead of the table, and the fields of the
+    // table are sorted by size, so that they are aligned with little padding
+    Table AddTable(std::initializer_list<Field> fields) {
+        std::uint16_t slots = 0;
+        for (const auto& f : fields) {
+            slots = std::max<std::uint16_t>(slots, f.slot + 1);
+        }
+
+        std::vector<Field> sorted(fields);
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const Field& a, const Field& b) {
+                             return a.size > b.size;
+                         });
+
+        Table table{};
+        std::vector<std::uint16_t> vtable(2 + slots);
+        std::size_t size = 4;
+        for (const auto& f : sorted) {
+            size = AlignUp(size, f.size);
+            vtable[2 + f.slot] = static_cast<std::uint16_t>(size);
+            table.fields[f.slot] = size;
+            size += f.size;
+        }
+        vtable[0] = static_cast<std::uint16_t>(vtable.size() * 2);
+        vtable[1] = static_cast<std::uint16_t>(size);
+
+        Align(kAlignment, vtable.size() * 2);
+        for (auto v : vtable) {
+            Put(v, 2);
+        }
+
+        table.pos = buf_.size();
+        buf_.resize(table.pos + AlignUp(size, 4));
+        Store(table.pos, vtable.size() * 2, 4);
+        for (const auto& f : sorted) {
+            table.fields[f.slot] += table.pos;
+            Store(table.fields[f.slot], f.value, f.size);
+        }
+        return table;
+    }
+
+    std::size_t AddString(std::string_view str) {
+        Align(4);
+        auto pos = buf_.size();
+        Put(str.size(), 4);
+        buf_.append(str);
+        buf_.push_back('\0');
+        return pos;
+    }
+
+    // returns the position of the vector, and the offsets of the elements
+    // follow the length
+    std::size_t AddOffsetVector(std::size_t n) {
+        Align(4);
+        auto pos = buf_.size();
+        Put(n, 4);
+        buf_.resize(pos + 4 + n * 4);
+        return pos;
+    }
+
+    // the structs are 8-byte aligned
+    std::size_t AddStructVector(const std::string& structs, std::size_t n) {
+        Align(kAlignment, 4);
+        auto pos = buf_.size();
+        Put(n, 4);
+        buf_.append(structs);
+        return pos;
+    }
+
+    void Patch(std::size_t at, std::size_t target) {
+        Store(at, target - at, 4);
+    }
+
+   private:
+    // pads the buffer, so that the object after the prefix is aligned
+    void Align(std::size_t align, std::size_t prefix = 0) {
+        buf_.resize(AlignUp(buf_.size() + prefix, align) - prefix);
+    }
+
+    void Put(std::uint64_t v, std::size_t size) {
+        buf_.resize(buf_.size() + size);
+        Store(buf_.size() - size, v, size);
+    }
+
+    void Store(std::size_t pos, std::uint64_t v, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            buf_[pos + i] = static_cast<char>(v >> (i * 8));
+        }
+    }
+
+    std::string buf_;
+};
+
+template <typename T>
+void PutType(FlatBuilder& b, std::size_t at) {
+    using V = ValueOf<T>;
+
+    if constexpr (IsBool<V>) {
+        b.Patch(at, b.AddTable({}).pos);
+    } else if constexpr (IsFloat<V>) {
+        auto precision = sizeof(V) == 4 ? kPrecisionSingle : kPrecisionDouble;
+        b.Patch(at, b.AddTable({FlatBuilder::Scalar(0, precision)}).pos);
+    } else if constexpr (IsFixedWidth<V>) {
+        using I = IntegerOf<V>;
+        auto t = b.AddTable({
+            FlatBuilder::Scalar(0, static_cast<std::int32_t>(sizeof(I) * 8)),
+            FlatBuilder::Scalar(1, std::is_signed_v<I>),
+        });
+        b.Patch(at, t.pos);
+    } else {
+        b.Patch(at, b.AddTable({}).pos);
+    }
+}
+
+template <typename T>
+consteval TypeId GetTypeId() {
+    using V = ValueOf<T>;
+
+    if constexpr (IsBool<V>) {
+        return kTypeBool;
+    } else if constexpr (IsFloat<V>) {
+        return kTypeFloatingPoint;
+    } else if constexpr (IsFixedWidth<V>) {
+        return kTypeInt;
+    } else {
+        return kTypeLargeUtf8;
+    }
+}
+
+template <typename T, std::size_t I>
+void PutField(FlatBuilder& b, std::size_t at) {
+    using F = FieldType<I, T>;
+
+    auto field = b.AddTable({
+        FlatBuilder::Offset(0),
+        FlatBuilder::Scalar(1, IsOptional<F>),
+        FlatBuilder::Scalar(2, GetTypeId<F>()),
+        FlatBuilder::Offset(3),
+        FlatBuilder::Offset(5),
+    });
+    b.Patch(at, field.pos);
+
+    b.Patch(field.fields[0], b.AddString(kFieldNames<T>[I]));
+    PutType<F>(b, field.fields[3]);
+    b.Patch(field.fields[5], b.AddOffsetVector(0));
+}
+
+template <typename T, std::size_t... Is>
+void PutFields(FlatBuilder& b, std::size_t vec, std::index_sequence<Is...>) {
+    (PutField<T, Is>(b, vec + 4 + Is * 4), ...);
+}
+
+// writes the schema, and patches the offset to it
+template <typename T>
+void PutSchema(FlatBuilder& b, std::size_t at) {
+    constexpr std::size_t N = FieldsCount<T>();
+
+    auto schema = b.AddTable({
+        FlatBuilder::Scalar(0, std::int16_t{0}),
+        FlatBuilder::Offset(1),
+    });
+    b.Patch(at, schema.pos);
+
+    auto vec = b.AddOffsetVector(N);
+    b.Patch(schema.fields[1], vec);
+    PutFields<T>(b, vec, std::make_index_sequence<N>{});
+}
+
+// the column of the record batch, which is the buffers of arrow, i.e., the
+// validity bitmap, the offsets if it's string, and the values
+struct Column {
+    std::int64_t null_count{0};
+    std::vector<std::string> buffers;
+};
+
+inline void SetBit(std::string& bitmap, std::size_t i) {
+    bitmap[i / 8] = static_cast<char>(bitmap[i / 8] | (1 << (i % 8)));
+}
+
+template <std::size_t I, typename T>
+Column BuildColumn(const std::vector<T>& rows) {
+    using F = FieldType<I, T>;
+    using V = ValueOf<F>;
+
+    static_assert(IsColumnType<V>(), "Unsupported type of the column");
+
+    const std::size_t n = rows.size();
+
+    Column column;
+    std::string validity((n + 7) / 8, '\0');
+    std::string values;
+    std::string offsets;
+
+    if constexpr (IsBool<V>) {
+        values.resize((n + 7) / 8);
+    } else if constexpr (IsFixedWidth<V>) {
+        values.resize(n * sizeof(V));
+    } else {
+        offsets.resize((n + 1) * 8);
+    }
+
+    std::int64_t bytes = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const V* v = nullptr;
+        if constexpr (IsOptional<F>) {
+            const auto& opt = GetField<I>(rows[i]);
+            v = opt ? std::addressof(*opt) : nullptr;
+        } else {
+            v = std::addressof(GetField<I>(rows[i]));
+        }
+
+        if (v) {
+            SetBit(validity, i);
+        } else {
+            ++column.null_count;
+        }
+
+        if constexpr (IsBool<V>) {
+            if (v && *v) SetBit(values, i);
+        } else if constexpr (IsFixedWidth<V>) {
+            if (v) {
+                using U = std::conditional_t<IsFloat<V>, V, IntegerOf<V>>;
+                StoreLittleEndian(values.data() + i * sizeof(V),
+                                  static_cast<U>(*v));
+            }
+        } else {
+            if (v) {
+                values.append(v->data(), v->size());
+                bytes += v->size();
+            }
+            StoreLittleEndian(offsets.data() + (i + 1) * 8, bytes);
+        }
+    }
+
+    // notes, the validity bitmap may be omitted if there are no nulls
+    if (column.null_count == 0) {
+        validity.clear();
+    }
+
+    column.buffers.push_back(std::move(validity));
+    if constexpr (IsStringLike<V>) {
+        column.buffers.push_back(std::move(offsets));
+    }
+    column.buffers.push_back(std::move(values));
+    return column;
+}
+
+template <typename T, std::size_t... Is>
+std::array<Column, sizeof...(Is)> BuildColumns(const std::vector<T>& rows,
+                                               std::index_sequence<Is...>) {
+    return {BuildColumn<Is>(rows)...};
+}
+
+template <typename Stream>
+void PutPrefix(Stream& s, std::size_t size) {
+    char buf[8];
+    StoreLittleEndian(buf, std::uint32_t{0xffffffff});
+    StoreLittleEndian(buf + 4, static_cast<std::int32_t>(size));
+    s.append(buf, sizeof(buf));
+}
+
+// the block of the message in the file, see File.fbs of arrow
+struct Block {
+    std::size_t offset{0};
+    std::size_t metadata{0};
+    std::size_t body{0};
+};
+
+// writes the encapsulated message, i.e., the continuation marker, the size of
+// metadata, the metadata and the body
+template <typename Stream>
+Block PutMessage(Stream& s, const FlatBuilder& b, std::string_view body) {
+    Block block;
+    block.offset = s.size();
+    block.metadata = AlignUp(8 + b.data().size(), kAlignment);
+    block.body = body.size();
+
+    PutPrefix(s, block.metadata - 8);
+    s.append(b.data());
+    s.append(block.metadata - 8 - b.data().size(), '\0');
+    s.append(body);
+    return block;
+}
+
+template <typename T>
+FlatBuilder BuildSchemaMessage() {
+    FlatBuilder b;
+    auto message = b.AddTable({
+        FlatBuilder::Scalar(0, kMetadataV5),
+        FlatBuilder::Scalar(1, kHeaderSchema),
+        FlatBuilder::Offset(2),
+        FlatBuilder::Scalar(3, std::int64_t{0}),
+    });
+    b.Finish(message.pos);
+    PutSchema<T>(b, message.fields[2]);
+    return b;
+}
+
+template <typename Stream, typename T>
+Block PutRecordBatch(Stream& s, const std::vector<T>& rows) {
+    constexpr std::size_t N = FieldsCount<T>();
+    auto columns = BuildColumns(rows, std::make_index_sequence<N>{});
+
+    std::string body;
+    std::string nodes;
+    std::string buffers;
+    for (const auto& column : columns) {
+        char buf[16];
+        StoreLittleEndian(buf, static_cast<std::int64_t>(rows.size()));
+        StoreLittleEndian(buf + 8, column.null_count);
+        nodes.append(buf, sizeof(buf));
+
+        for (const auto& buffer : column.buffers) {
+            StoreLittleEndian(buf, static_cast<std::int64_t>(body.size()));
+            auto size = static_cast<std::int64_t>(buffer.size());
+            StoreLittleEndian(buf + 8, size);
+            buffers.append(buf, sizeof(buf));
+
+            body.append(buffer);
+            body.resize(AlignUp(body.size(), kAlignment));
+        }
+    }
+
+    FlatBuilder b;
+    auto message = b.AddTable({
+        FlatBuilder::Scalar(0, kMetadataV5),
+        FlatBuilder::Scalar(1, kHeaderRecordBatch),
+        FlatBuilder::Offset(2),
+        FlatBuilder::Scalar(3, static_cast<std::int64_t>(body.size())),
+    });
+    b.Finish(message.pos);
+
+    auto batch = b.AddTable({
+        FlatBuilder::Scalar(0, static_cast<std::int64_t>(rows.size())),
+        FlatBuilder::Offset(1),
+        FlatBuilder::Offset(2),
+    });
+    b.Patch(message.fields[2], batch.pos);
+    b.Patch(batch.fields[1], b.AddStructVector(nodes, N));
+    b.Patch(batch.fields[2],
+            b.AddStructVector(buffers, buffers.size() / 16));
+
+    return PutMessage(s, b, body);
+}
+
+template <typename Stream>
+void PutEndOfStream(Stream& s) {
+    PutPrefix(s, 0);
+}
+
+template <typename T>
+FlatBuilder BuildFooter(const Block& batch) {
+    FlatBuilder b;
+    auto footer = b.AddTable({
+        FlatBuilder::Scalar(0, kMetadataV5),
+        FlatBuilder::Offset(1),
+        FlatBuilder::Offset(2),
+        FlatBuilder::Offset(3),
+    });
+    b.Finish(footer.pos);
+    PutSchema<T>(b, footer.fields[1]);
+
+    // notes, only the record batches are listed, not the schema
+    b.Patch(footer.fields[2], b.AddStructVector("", 0));
+
+    char buf[24] = {};
+    StoreLittleEndian(buf, static_cast<std::int64_t>(batch.offset));
+    StoreLittleEndian(buf + 8, static_cast<std::int32_t>(batch.metadata));
+    StoreLittleEndian(buf + 16, static_cast<std::int64_t>(batch.body));
+    b.Patch(footer.fields[3],
+            b.AddStructVector(std::string(buf, sizeof(buf)), 1));
+    return b;
+}
+
+inline constexpr std::string_view kMagic{"ARROW1\0\0", 8};
+
+}  // namespace _
+
+// writes the rows as the arrow ipc streaming format, which is the schema
+// message, one record batch and the end-of-stream marker
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToArrowStream(Stream& s, const std::vector<T>& rows) {
+    _::PutMessage(s, _::BuildSchemaMessage<T>(), {});
+    _::PutRecordBatch(s, rows);
+    _::PutEndOfStream(s);
+}
+
+// writes the rows as the arrow ipc file format, i.e., feather v2, which is the
+// streaming format wrapped by the magic and the footer
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToArrowFile(Stream& s, const std::vector<T>& rows) {
+    auto base = s.size();
+    s.append(_::kMagic);
+
+    _::PutMessage(s, _::BuildSchemaMessage<T>(), {});
+    auto batch = _::PutRecordBatch(s, rows);
+    _::PutEndOfStream(s);
+
+    // notes, the offset of the block is relative to the beginning of the file
+    batch.offset -= base;
+
+    auto footer = _::BuildFooter<T>(batch);
+    s.append(footer.data());
+
+    char buf[4];
+    StoreLittleEndian(buf, static_cast<std::int32_t>(footer.data().size()));
+    s.append(buf, sizeof(buf));
+    s.append(_::kMagic.substr(0, 6));
+}
+
+}  // namespace arrow
+}  // namespace reflpp
@@ -0,0 +1,674 @@
+#pragma once
+
+#include <binary/binary_writer.h>
+#include <binary/ec.h>
+#include <byte_order.h>
+#include <field_name.h>
+#include <fingerprint.h>
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace reflpp {
+namespace binary {
+
+namespace _ {
+
+struct Decoder {
+    Decoder(std::string_view data) : data_(data) {}
+
+    Decoder(Decoder&&) = default;
+    Decoder& operator=(Decoder&&) = default;
+
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
+
+    // notes, only the first error is kept
+    bool E(int ec) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = error_category.message(ec);
+        }
+        return false;
+    }
+
+    template <typename... Args>
+    bool E(int ec, const char* fmt, const Args&... args) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        return false;
+    }
+
+    bool IsEof() const { return cursor_ >= data_.size(); }
+    bool IsError() const { return static_cast<bool>(ec_); }
+
+    std::size_t remaining() const { return data_.size() - cursor_; }
+
+    std::error_code error() const { return ec_; }
+    std::string_view detail_error() const { return detail_emsg_; }
+
+    bool Take(std::size_t n, const char** p) {
+        if (IsError()) return false;
+
+        if (remaining() < n) {
+            return E(kErrorUnexpectedTerminate);
+        }
+
+        *p = data_.data() + cursor_;
+        cursor_ += n;
+        return true;
+    }
+
+    bool Copy(void* dst, std::size_t n) {
+        const char* p = nullptr;
+        if (!Take(n, &p)) return false;
+
+        if (n > 0) {
+            std::memcpy(dst, p, n);
+        }
+        return true;
+    }
+
+    bool ReadVarint(std::uint64_t* v) {
+        // the fast path of the single byte
+        if (!IsError() && !IsEof() && !(data_[cursor_] & 0x80)) {
+            *v = static_cast<std::uint8_t>(data_[cursor_++]);
+            return true;
+        }
+
+        std::uint64_t n = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const char* p = nullptr;
+            if (!Take(1, &p)) return false;
+
+            auto b = static_cast<std::uint8_t>(*p);
+            n |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                *v = n;
+                return true;
+            }
+        }
+        return E(kErrorParseFailure, "invalid varint");
+    }
+
+    // the length of strings and containers. notes, each element takes one
+    // byte at least, so the length can't exceed the remaining bytes, which
+    // prevents the huge allocation from the malformed input
+    bool ReadLength(std::uint64_t* n, std::size_t elem_size = 1) {
+        if (!ReadVarint(n)) return false;
+
+        if (*n > remaining() / elem_size) {
+            return E(kErrorLengthOverflow, "length {} exceeds the input", *n);
+        }
+        return true;
+    }
+
+    // the length of bit-packed containers, each element takes one bit at
+    // least
+    bool ReadBitLength(std::uint64_t* n) {
+        if (!ReadVarint(n)) return false;
+
+        if (*n / 8 > remaining()) {
+            return E(kErrorLengthOverflow, "length {} exceeds the input", *n);
+        }
+        return true;
+    }
+
+    std::error_code ec_;
+    std::string detail_emsg_;
+
+    std::size_t cursor_{0};
+    std::string_view data_;
+};
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+void ParseItem(Decoder& d, T& value);
+
+template <typename T, std::enable_if_t<IsBool<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    const char* p = nullptr;
+    if (!d.Take(1, &p)) return;
+
+    if (*p != 0 && *p != 1) {
+        d.E(kErrorParseFailure, "invalid bool");
+        return;
+    }
+    value = *p == 1;
+}
+
+template <typename T, std::enable_if_t<IsScalar<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    if constexpr (IsMemcpyable<T>) {
+        d.Copy(&value, sizeof(T));
+    } else if constexpr (IsEnum<T>) {
+        std::underlying_type_t<T> v{};
+        ParseItem(d, v);
+        value = static_cast<T>(v);
+    } else {
+        const char* p = nullptr;
+        if (d.Take(sizeof(T), &p)) {
+            value = LoadLittleEndian<T>(p);
+        }
+    }
+}
+
+template <typename T, std::enable_if_t<IsString<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using CharType = typename T::value_type;
+
+    std::uint64_t n = 0;
+    if (!d.ReadLength(&n, sizeof(CharType))) return;
+
+    value.resize(n);
+    if constexpr (IsMemcpyable<CharType>) {
+        d.Copy(value.data(), n * sizeof(CharType));
+    } else {
+        for (auto& ch : value) {
+            ParseItem(d, ch);
+        }
+    }
+}
+
+// notes, the string view refers to the input buffer, which should outlive it
+template <typename T, std::enable_if_t<IsStringView<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    static_assert(sizeof(typename T::value_type) == 1,
+                  "Only the narrow string view is supported");
+
+    std::uint64_t n = 0;
+    const char* p = nullptr;
+    if (d.ReadLength(&n) && d.Take(n, &p)) {
+        value = T(p, n);
+    }
+}
+
+template <typename T, std::enable_if_t<IsMapContainer<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using KeyType = typename U::key_type;
+
+    std::uint64_t n = 0;
+    if (!d.ReadLength(&n)) return;
+
+    value.clear();
+    for (std::uint64_t i = 0; i < n && !d.IsError(); ++i) {
+        KeyType key{};
+        ParseItem(d, key);
+        ParseItem(d, value[std::move(key)]);
+    }
+}
+
+template <typename T, std::enable_if_t<IsSequenceContainer<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using ValueType = typename T::value_type;
+
+    if constexpr (IsTemplateOf<std::vector, T> && IsMemcpyable<ValueType>) {
+        std::uint64_t n = 0;
+        if (!d.ReadLength(&n, sizeof(ValueType))) return;
+
+        value.resize(n);
+        d.Copy(value.data(), n * sizeof(ValueType));
+    } else {
+        std::uint64_t n = 0;
+        if (!d.ReadLength(&n)) return;
+
+        value.clear();
+        for (std::uint64_t i = 0; i < n && !d.IsError(); ++i) {
+            if constexpr (IsBool<ValueType>) {
+                // notes, std::vector<bool> returns the proxy
+                bool v = false;
+                ParseItem(d, v);
+                value.push_back(v);
+            } else {
+                ParseItem(d, value.emplace_back());
+            }
+        }
+    }
+}
+
+template <typename T, std::enable_if_t<IsSetContainer<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using KeyType = typename U::key_type;
+
+    std::uint64_t n = 0;
+    if (!d.ReadLength(&n)) return;
+
+    value.clear();
+    for (std::uint64_t i = 0; i < n && !d.IsError(); ++i) {
+        KeyType v{};
+        ParseItem(d, v);
+        value.insert(std::move(v));
+    }
+}
+
+template <typename T, std::enable_if_t<IsOptional<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using ValueType = typename U::value_type;
+
+    bool has_value = false;
+    ParseItem(d, has_value);
+    if (d.IsError()) return;
+
+    if (has_value) {
+        ValueType v{};
+        ParseItem(d, v);
+        value = std::move(v);
+    } else {
+        value = std::nullopt;
+    }
+}
+
+template <typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using ValueType = typename U::element_type;
+
+    bool has_value = false;
+    ParseItem(d, has_value);
+    if (d.IsError()) return;
+
+    if (has_value) {
+        if constexpr (IsUniquePtr<T>) {
+            value = std::make_unique<ValueType>();
+        } else {
+            value = std::make_shared<ValueType>();
+        }
+        ParseItem(d, *value);
+    } else {
+        value = nullptr;
+    }
+}
+
+template <typename T, std::size_t... Is>
+void ParseTuple(Decoder& d, T& value, std::index_sequence<Is...>) {
+    (ParseItem(d, std::get<Is>(value)), ...);
+}
+
+template <typename T, std::enable_if_t<IsTuple<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    constexpr std::size_t size = std::tuple_size_v<T>;
+    ParseTuple(d, value, std::make_index_sequence<size>{});
+}
+
+template <typename T, std::size_t... Is>
+void ParseVariant(Decoder& d, T& value, std::size_t idx,
+                  std::index_sequence<Is...>) {
+    ((idx == Is ? ParseItem(d, value.template emplace<Is>()) : void()), ...);
+}
+
+template <typename T, std::enable_if_t<IsVariant<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    constexpr std::size_t size = std::variant_size_v<T>;
+
+    std::uint64_t idx = 0;
+    if (!d.ReadVarint(&idx)) return;
+
+    if (idx >= size) {
+        d.E(kErrorInvalidVariant, "variant index {} is out of range", idx);
+        return;
+    }
+    ParseVariant(d, value, idx, std::make_index_sequence<size>{});
+}
+
+template <typename T, std::enable_if_t<IsFixedArray<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    if constexpr (IsMemcpyable<T>) {
+        d.Copy(std::addressof(value), sizeof(T));
+    } else {
+        for (auto& e : value) {
+            ParseItem(d, e);
+        }
+    }
+}
+
+inline std::uint64_t ReadBits(const char* p, std::size_t bit, int width) {
+    p += bit / 8;
+    int shift = bit % 8;
+
+    std::uint64_t v = 0;
+    for (int done = 0; done < width; ++p) {
+        v |= (static_cast<std::uint64_t>(static_cast<std::uint8_t>(*p)) >>
+              shift)
+             << done;
+        done += 8 - shift;
+        shift = 0;
+    }
+    return width == 64 ? v : v & ((std::uint64_t{1} << width) - 1);
+}
+
+// unpacks the values from the bits. notes, the 8-byte word at the first byte
+// of the value is loaded while it's in bounds, which covers the value if the
+// width is 56 bits at most. the words of four values are gathered by avx2 if
+// it's enabled, e.g., -mavx2 or -march=native, otherwise they are loaded one
+// by one, and the tail is read byte by byte
+template <typename U>
+void UnpackBits(const char* p, std::size_t bytes, int width, U base, U* out,
+                std::size_t n) {
+    std::size_t i = 0;
+    if (width <= 56 && bytes >= 8) {
+        std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+        std::size_t fast = std::min(n, ((bytes - 8) * 8 + 7) / width + 1);
+#if defined(__AVX2__)
+        const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+        const __m256i vbase = _mm256_set1_epi64x(
+            static_cast<long long>(static_cast<std::uint64_t>(base)));
+        const __m256i vstep = _mm256_set1_epi64x(4ll * width);
+        const __m256i seven = _mm256_set1_epi64x(7);
+        __m256i bits = _mm256_setr_epi64x(0, width, 2ll * width, 3ll * width);
+        for (; i + 4 <= fast; i += 4) {
+            __m256i word = _mm256_i64gather_epi64(
+                reinterpret_cast<const long long*>(p),
+                _mm256_srli_epi64(bits, 3), 1);
+            word = _mm256_srlv_epi64(word, _mm256_and_si256(bits, seven));
+            word = _mm256_add_epi64(_mm256_and_si256(word, vmask), vbase);
+            bits = _mm256_add_epi64(bits, vstep);
+
+            if constexpr (sizeof(U) == 8) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), word);
+            } else {
+                alignas(32) std::uint64_t lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), word);
+                for (int k = 0; k < 4; ++k) {
+                    out[i + k] = static_cast<U>(lanes[k]);
+                }
+            }
+        }
+#endif
+        for (; i < fast; ++i) {
+            std::size_t bit = i * width;
+            auto word = LoadLittleEndian<std::uint64_t>(p + bit / 8);
+            out[i] = static_cast<U>(((word >> (bit % 8)) & mask) + base);
+        }
+    }
+
+    for (; i < n; ++i) {
+        out[i] = static_cast<U>(ReadBits(p, i * width, width) + base);
+    }
+}
+
+template <typename T>
+void ParseDelta(Decoder& d, T& value) {
+    using U = UnsignedOf<ElementOf<T>>;
+    using E = ElementOf<T>;
+
+    std::uint64_t n = 0;
+    if (!d.ReadLength(&n)) return;
+
+    value.resize(n);
+
+    U prev = 0;
+    for (auto& e : value) {
+        std::uint64_t v = 0;
+        if (!d.ReadVarint(&v)) return;
+
+        prev += static_cast<U>(ZigzagDecode(v));
+        e = static_cast<E>(prev);
+    }
+}
+
+template <typename T>
+void ParseBitPacked(Decoder& d, T& value) {
+    using E = ElementOf<T>;
+    using U = UnsignedOf<E>;
+
+    std::uint64_t n = 0;
+    if (!d.ReadBitLength(&n)) return;
+
+    value.resize(n);
+    if (n == 0) return;
+
+    const char* p = nullptr;
+    if (!d.Take(sizeof(E) + 1, &p)) return;
+
+    auto base = static_cast<U>(LoadLittleEndian<E>(p));
+    int width = static_cast<std::uint8_t>(p[sizeof(E)]);
+    if (width < 1 || width > static_cast<int>(sizeof(E) * 8)) {
+        d.E(kErrorParseFailure, "invalid bit width {}", width);
+        return;
+    }
+
+    std::size_t bytes = (n * width + 7) / 8;
+    if (!d.Take(bytes, &p)) return;
+
+    if constexpr (IsTemplateOf<std::vector, T>) {
+        // notes, the signed and unsigned types can alias each other
+        UnpackBits(p, bytes, width, base, reinterpret_cast<U*>(value.data()),
+                   n);
+    } else {
+        std::size_t bit = 0;
+        for (auto& e : value) {
+            e = static_cast<E>(static_cast<U>(ReadBits(p, bit, width) + base));
+            bit += width;
+        }
+    }
+}
+
+template <typename T>
+void ParseBitset(Decoder& d, T& value) {
+    std::uint64_t n = 0;
+    if (!d.ReadBitLength(&n)) return;
+
+    const char* p = nullptr;
+    if (!d.Take((n + 7) / 8, &p)) return;
+
+    value.resize(n);
+
+    std::size_t i = 0;
+    for (auto&& e : value) {
+        e = (static_cast<std::uint8_t>(p[i / 8]) >> (i % 8)) & 1;
+        ++i;
+    }
+}
+
+template <Encoding E, typename T>
+void ParseField(Decoder& d, T& value) {
+    static_assert(IsValidEncoding<E, T>(), "Invalid encoding of the field");
+
+    if constexpr (E == kDelta) {
+        ParseDelta(d, value);
+    } else if constexpr (E == kBitPacked) {
+        ParseBitPacked(d, value);
+    } else if constexpr (E == kBitset) {
+        ParseBitset(d, value);
+    } else {
+        ParseItem(d, value);
+    }
+}
+
+template <std::size_t I, typename T>
+void ParseFields(Decoder& d, T& value) {
+    if constexpr (I < FieldsCount<T>()) {
+        constexpr auto& layout = kLayout<T>;
+        constexpr std::size_t J = layout.run_ends[I];
+
+        if constexpr (J > I + 1) {
+            constexpr std::size_t bytes =
+                layout.offsets[J - 1] + layout.sizes[J - 1] - layout.offsets[I];
+            d.Copy(std::addressof(GetField<I>(value)), bytes);
+        } else {
+            ParseField<kEncodings<T>[I]>(d, GetField<I>(value));
+        }
+        ParseFields<J>(d, value);
+    }
+}
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int>>
+void ParseItem(Decoder& d, T& value) {
+    if constexpr (IsMemcpyable<T>) {
+        d.Copy(std::addressof(value), sizeof(T));
+    } else {
+        ParseFields<0>(d, value);
+    }
+}
+
+// the size of each field in the body, which is read from the field table
+struct FieldEntry {
+    std::uint64_t fingerprint{0};
+    std::uint64_t offset{0};
+    std::uint64_t size{0};
+};
+
+// decodes the field from its slice of the body, and the slice should be
+// consumed exactly
+template <Encoding E, typename T>
+void ParseSlice(Decoder& d, std::string_view name, std::string_view slice,
+                T& value) {
+    Decoder sub(slice);
+    ParseField<E>(sub, value);
+    if (!sub.IsError() && !sub.IsEof()) {
+        sub.E(kErrorParseFailure, "unexpected trailing bytes");
+    }
+
+    if (sub.IsError()) {
+        d.E(sub.error().value(), "field `{}`: {}", name, sub.detail_error());
+    }
+}
+
+template <std::size_t I, typename T>
+void ParseMatchedField(Decoder& d, std::string_view body,
+                       const std::vector<FieldEntry>& entries, T& value) {
+    constexpr auto& names = kFieldNames<T>;
+    constexpr auto fingerprint = kVersionFieldFingerprints<T>[I];
+
+    if (d.IsError()) return;
+
+    for (const auto& entry : entries) {
+        if (entry.fingerprint == fingerprint) {
+            ParseSlice<kEncodings<T>[I]>(d, names[I],
+                                         body.substr(entry.offset, entry.size),
+                                         GetField<I>(value));
+            return;
+        }
+    }
+}
+
+template <typename T, std::size_t... Is>
+void ParseMatchedFields(Decoder& d, std::string_view body,
+                        const std::vector<FieldEntry>& entries, T& value,
+                        std::index_sequence<Is...>) {
+    (ParseMatchedField<Is>(d, body, entries, value), ...);
+}
+
+// the fields are matched by the fingerprints of name and type. notes, the
+// missing fields keep the values, and the unknown fields are skipped
+template <typename T>
+void ParseFieldTable(Decoder& d, std::string_view body, T& value) {
+    // each entry takes 9 bytes at least
+    std::uint64_t n = 0;
+    if (!d.ReadLength(&n, 9)) return;
+
+    std::vector<FieldEntry> entries(n);
+    std::uint64_t offset = 0;
+    for (auto& entry : entries) {
+        const char* p = nullptr;
+        if (!d.Take(8, &p) || !d.ReadVarint(&entry.size)) return;
+
+        entry.fingerprint = LoadLittleEndian<std::uint64_t>(p);
+        entry.offset = offset;
+        if (entry.size > body.size() - offset) {
+            d.E(kErrorParseFailure, "field size {} exceeds the body",
+                entry.size);
+            return;
+        }
+        offset += entry.size;
+    }
+
+    if (offset != body.size()) {
+        d.E(kErrorParseFailure, "field sizes mismatch the body");
+        return;
+    }
+
+    ParseMatchedFields(d, body, entries, value,
+                       std::make_index_sequence<FieldsCount<T>()>{});
+}
+
+template <typename T>
+void ParseVersioned(Decoder& d, T& value) {
+    const char* p = nullptr;
+    if (!d.Take(16, &p)) return;
+
+    auto fingerprint = LoadLittleEndian<std::uint64_t>(p);
+    auto size = LoadLittleEndian<std::uint64_t>(p + 8);
+    if (size > d.remaining()) {
+        d.E(kErrorLengthOverflow, "length {} exceeds the input", size);
+        return;
+    }
+
+    auto end = d.cursor_ + size;
+    auto body = d.data_.substr(d.cursor_, size);
+    if (fingerprint == kVersionFingerprint<T>) {
+        // the fast path, which is the same as the native binary, and the
+        // field table is skipped
+        ParseItem(d, value);
+        if (!d.IsError() && d.cursor_ != end) {
+            d.E(kErrorParseFailure, "body size mismatch");
+            return;
+        }
+        d.cursor_ = d.data_.size();
+        return;
+    }
+
+    d.cursor_ = end;
+    ParseFieldTable(d, body, value);
+}
+
+}  // namespace _
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromBinary(std::string_view data, T& value,
+                           std::string* detail_emsg = nullptr) {
+    _::Decoder d(data);
+
+    _::ParseItem(d, value);
+    if (!d.IsError() && !d.IsEof()) {
+        d.E(kErrorParseFailure, "unexpected trailing bytes");
+    }
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+// reads the struct written by ToVersionedBinary, which may be written by the
+// other version of the struct. notes, the field with the different name or
+// type is treated as the different field
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromVersionedBinary(std::string_view data, T& value,
+                                    std::string* detail_emsg = nullptr) {
+    _::Decoder d(data);
+
+    _::ParseVersioned(d, value);
+    if (!d.IsError() && !d.IsEof()) {
+        d.E(kErrorParseFailure, "unexpected trailing bytes");
+    }
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+}  // namespace binary
+}  // namespace reflpp
@@ -0,0 +1,668 @@
+#pragma once
+
+#include <byte_order.h>
+#include <field_access.h>
+#include <fields_count.h>
+#include <fingerprint.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// the native binary format is not self-describing, both sides should agree on
+// the type. the format is as follows:
+//   - scalars are stored as fixed-width little-endian, bool takes one byte
+//   - strings and containers are prefixed with the varint length
+//   - fixed arrays, tuples and structs are stored element by element
+//   - optional and smart pointers are prefixed with one presence byte
+//   - variants are prefixed with the varint index of the alternative
+// notes, the trivially copyable and padding-free runs of fields are copied as
+// a whole, as their memory representation is the same as the encoding
+//
+// the integer and bool containers can opt in the compact encodings by fields,
+// see BinaryFields
+namespace reflpp {
+namespace binary {
+
+namespace _ {
+
+template <typename T>
+inline constexpr bool IsScalar = IsNumeric<T> || IsChar<T> || IsEnum<T>;
+
+template <typename T, typename = void>
+struct IsMemcpyableImpl : std::false_type {};
+
+template <typename T>
+inline constexpr bool IsMemcpyable = IsMemcpyableImpl<RemoveCVRef<T>>::value;
+
+// notes, bool is excluded, as not all of bytes are valid bool values
+template <typename T>
+struct IsMemcpyableImpl<T, std::enable_if_t<IsScalar<T>>>
+    : std::bool_constant<sizeof(T) == 1 ||
+                         std::endian::native == std::endian::little> {};
+
+template <typename T, std::size_t N>
+struct IsMemcpyableImpl<T[N]> : IsMemcpyableImpl<T> {};
+
+template <typename T, std::size_t N>
+struct IsMemcpyableImpl<std::array<T, N>>
+    : std::bool_constant<IsMemcpyable<T> &&
+                         sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+// the struct is copied as a whole if all of fields are memcpyable, and there
+// is no padding between them
+template <typename T, std::size_t... Is>
+consteval bool IsPackedStruct(std::index_sequence<Is...>) {
+    return sizeof...(Is) > 0 && (IsMemcpyable<FieldType<Is, T>> && ...) &&
+           (sizeof(FieldType<Is, T>) + ... + 0) == sizeof(T);
+}
+
+template <typename T>
+struct IsMemcpyableImpl<T, std::enable_if_t<IsAggregateStruct<T>>>
+    : std::bool_constant<IsPackedStruct<T>(
+          std::make_index_sequence<FieldsCount<T>()>{})> {};
+
+template <std::size_t N>
+struct Layout {
+    std::array<std::size_t, N> offsets{};
+    std::array<std::size_t, N> sizes{};
+
+    // the end (exclusive) of the memcpy run, which starts at the field
+    std::array<std::size_t, N> run_ends{};
+};
+
+// notes, the offsets are only trusted if they are proven, i.e., measured or
+// free of padding, otherwise every field is encoded on its own, since the
+// predicted offsets could miss the fields moved by alignas
+template <typename T, std::size_t... Is>
+consteval auto GetLayoutImpl(std::index_sequence<Is...>) {
+    constexpr std::size_t N = sizeof...(Is);
+    constexpr auto& field_layout = ::reflpp::_::kFieldLayout<T>;
+
+    Layout<N> layout;
+    if constexpr (N > 0) {
+        constexpr std::array<bool, N> trivial{
+            IsMemcpyable<FieldType<Is, T>>...};
+
+        layout.offsets = field_layout.offsets;
+        layout.sizes = {sizeof(FieldType<Is, T>)...};
+
+        for (std::size_t i = N; i-- > 0;) {
+            layout.run_ends[i] = i + 1;
+            if (field_layout.proven && i + 1 < N && trivial[i] &&
+                trivial[i + 1] &&
+                layout.offsets[i] + layout.sizes[i] == layout.offsets[i + 1]) {
+                layout.run_ends[i] = layout.run_ends[i + 1];
+            }
+        }
+    }
+    return layout;
+}
+
+template <typename T>
+inline constexpr auto kLayout =
+    GetLayoutImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+template <typename Stream>
+inline void PutBytes(Stream& s, const void* p, std::size_t n) {
+    s.append(static_cast<const char*>(p), n);
+}
+
+// the unsigned LEB128 encoding
+template <typename Stream>
+inline void PutVarint(Stream& s, std::uint64_t n) {
+    char buf[10];
+    std::size_t len = 0;
+    while (n >= 0x80) {
+        buf[len++] = static_cast<char>(n | 0x80);
+        n >>= 7;
+    }
+    buf[len++] = static_cast<char>(n);
+    s.append(buf, len);
+}
+
+inline constexpr std::uint64_t ZigzagEncode(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^
+           static_cast<std::uint64_t>(v >> 63);
+}
+
+inline constexpr std::int64_t ZigzagDecode(std::uint64_t v) {
+    return static_cast<std::int64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+}  // namespace _
+
+template <typename T>
+inline constexpr bool IsMemcpyable = _::IsMemcpyable<T>;
+
+// the encoding of the field, which are as follows:
+//   - kPlain is the default, see the format above
+//   - kDelta is for the integer containers, the differences between the
+//     adjacent elements are stored as the zigzag varints, e.g., timestamps
+//   - kBitPacked is for the integer containers, the elements are stored as
+//     the offsets from the minimum in the fixed bit width, e.g., small ints
+//   - kBitset is for the bool containers, the elements are stored as bits
+// all of them are prefixed with the varint length
+enum Encoding : std::uint8_t {
+    kPlain,
+    kDelta,
+    kBitPacked,
+    kBitset,
+};
+
+// by default, all of fields are kPlain. specializes it to override the
+// encodings of fields, e.g.,
+//
+//   template <>
+//   struct BinaryFields<Series> {
+//       static constexpr std::array<Encoding, 3> value{
+//           kPlain,
+//           kDelta,
+//           kBitset,
+//       };
+//   };
+//
+// notes, both sides should agree on the encodings
+template <typename T>
+struct BinaryFields {};
+
+template <typename Stream, typename T>
+inline void FormatBinaryValue(Stream& s, const std::optional<T>&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsMapContainer<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSequenceContainer<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSetContainer<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsFixedArray<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T&);
+
+template <typename Stream>
+inline void FormatBinaryValue(Stream& s, bool b) {
+    s.push_back(b ? 1 : 0);
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<_::IsScalar<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, T value) {
+    if constexpr (IsMemcpyable<T>) {
+        _::PutBytes(s, &value, sizeof(T));
+    } else if constexpr (IsEnum<T>) {
+        using U = std::underlying_type_t<T>;
+        FormatBinaryValue(s, static_cast<U>(value));
+    } else {
+        char buf[sizeof(T)];
+        StoreLittleEndian(buf, value);
+        s.append(buf, sizeof(buf));
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsStringLike<T>, int> = 0>
+inline void FormatBinaryValue(Stream& s, const T& t) {
+    using CharType = typename T::value_type;
+
+    _::PutVarint(s, t.size());
+    if constexpr (IsMemcpyable<CharType>) {
+        _::PutBytes(s, t.data(), t.size() * sizeof(CharType));
+    } else {
+        for (auto ch : t) {
+            FormatBinaryValue(s, ch);
+        }
+    }
+}
+
+template <typename Stream, typename T>
+inline void FormatBinaryValue(Stream& s, const std::optional<T>& val) {
+    s.push_back(val ? 1 : 0);
+    if (val) {
+        FormatBinaryValue(s, *val);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsFixedArray<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& v) {
+    if constexpr (IsMemcpyable<T>) {
+        _::PutBytes(s, std::addressof(v), sizeof(T));
+    } else {
+        for (const auto& e : v) {
+            FormatBinaryValue(s, e);
+        }
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsMapContainer<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& v) {
+    _::PutVarint(s, v.size());
+    for (const auto& [key, val] : v) {
+        FormatBinaryValue(s, key);
+        FormatBinaryValue(s, val);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsSetContainer<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& v) {
+    _::PutVarint(s, v.size());
+    for (const auto& e : v) {
+        FormatBinaryValue(s, e);
+    }
+}
+
+// notes, the elements of std::vector are contiguous, which are copied as a
+// whole if they are memcpyable
+template <typename Stream, typename T,
+          std::enable_if_t<IsSequenceContainer<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& v) {
+    using ValueType = typename T::value_type;
+
+    _::PutVarint(s, v.size());
+    if constexpr (IsTemplateOf<std::vector, T> && IsMemcpyable<ValueType>) {
+        _::PutBytes(s, v.data(), v.size() * sizeof(ValueType));
+    } else {
+        for (const auto& e : v) {
+            FormatBinaryValue(s, e);
+        }
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& v) {
+    s.push_back(v ? 1 : 0);
+    if (v) {
+        FormatBinaryValue(s, *v);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& t) {
+    ForEach(t, [&s](auto, const auto& v) { FormatBinaryValue(s, v); });
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& t) {
+    _::PutVarint(s, t.index());
+    std::visit([&s](const auto& value) { FormatBinaryValue(s, value); }, t);
+}
+
+namespace _ {
+
+template <typename T, typename = void>
+struct HasEncodings : std::false_type {};
+
+template <typename T>
+struct HasEncodings<T, std::void_t<decltype(BinaryFields<T>::value)>>
+    : std::true_type {};
+
+template <typename T>
+consteval auto GetEncodings() {
+    constexpr std::size_t N = FieldsCount<T>();
+
+    if constexpr (HasEncodings<T>::value) {
+        static_assert(BinaryFields<T>::value.size() == N,
+                      "The count of encodings mismatch");
+        return BinaryFields<T>::value;
+    } else {
+        return std::array<Encoding, N>{};
+    }
+}
+
+template <typename T>
+inline constexpr auto kEncodings = GetEncodings<T>();
+
+template <typename T, typename = void>
+struct ElementOfImpl {
+    using type = void;
+};
+
+template <typename T>
+struct ElementOfImpl<T, std::enable_if_t<IsSequenceContainer<T>>> {
+    using type = typename T::value_type;
+};
+
+template <typename T>
+using ElementOf = typename ElementOfImpl<RemoveCVRef<T>>::type;
+
+template <Encoding E, typename T>
+consteval bool IsValidEncoding() {
+    using U = ElementOf<T>;
+
+    if constexpr (E == kDelta || E == kBitPacked) {
+        return IsIntegral<U> && !IsBool<U>;
+    } else if constexpr (E == kBitset) {
+        return IsBool<U>;
+    } else {
+        return true;
+    }
+}
+
+template <typename T>
+using UnsignedOf = std::make_unsigned_t<T>;
+
+// the bits are stored in the little-endian order, i.e., the first value takes
+// the lowest bits of the first byte
+inline void WriteBits(char* p, std::size_t bit, int width, std::uint64_t v) {
+    p += bit / 8;
+    int shift = bit % 8;
+    for (int done = 0; done < width; ++p) {
+        *p = static_cast<char>(static_cast<std::uint8_t>(*p) | (v << shift));
+        done += 8 - shift;
+        v >>= 8 - shift;
+        shift = 0;
+    }
+}
+
+template <typename Stream, typename T>
+inline void PutDelta(Stream& s, const T& v) {
+    using U = UnsignedOf<ElementOf<T>>;
+    using S = std::make_signed_t<U>;
+
+    PutVarint(s, v.size());
+
+    U prev = 0;
+    for (auto e : v) {
+        auto delta = static_cast<S>(static_cast<U>(e) - prev);
+        PutVarint(s, ZigzagEncode(delta));
+        prev = static_cast<U>(e);
+    }
+}
+
+// notes, the width is one bit at least, so that the length is bounded by the
+// size of the input when decoding
+template <typename Stream, typename T>
+inline void PutBitPacked(Stream& s, const T& v) {
+    using E = ElementOf<T>;
+    using U = UnsignedOf<E>;
+
+    PutVarint(s, v.size());
+    if (v.empty()) return;
+
+    auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+    U base = static_cast<U>(*lo);
+    auto range = static_cast<U>(*hi - base);
+    int width = std::max(1, static_cast<int>(std::bit_width(range)));
+
+    char buf[sizeof(E) + 1];
+    StoreLittleEndian(buf, static_cast<E>(base));
+    buf[sizeof(E)] = static_cast<char>(width);
+    s.append(buf, sizeof(buf));
+
+    auto pos = s.size();
+    s.append((v.size() * width + 7) / 8, '\0');
+
+    char* p = s.data() + pos;
+    std::size_t bit = 0;
+    for (auto e : v) {
+        WriteBits(p, bit, width, static_cast<U>(e - base));
+        bit += width;
+    }
+}
+
+template <typename Stream, typename T>
+inline void PutBitset(Stream& s, const T& v) {
+    PutVarint(s, v.size());
+
+    std::uint8_t byte = 0;
+    std::size_t i = 0;
+    for (bool e : v) {
+        byte |= static_cast<std::uint8_t>(e) << (i % 8);
+        if (++i % 8 == 0) {
+            s.push_back(static_cast<char>(byte));
+            byte = 0;
+        }
+    }
+    if (i % 8 != 0) {
+        s.push_back(static_cast<char>(byte));
+    }
+}
+
+template <Encoding E, typename Stream, typename T>
+inline void FormatField(Stream& s, const T& v) {
+    static_assert(IsValidEncoding<E, T>(), "Invalid encoding of the field");
+
+    if constexpr (E == kDelta) {
+        PutDelta(s, v);
+    } else if constexpr (E == kBitPacked) {
+        PutBitPacked(s, v);
+    } else if constexpr (E == kBitset) {
+        PutBitset(s, v);
+    } else {
+        FormatBinaryValue(s, v);
+    }
+}
+
+template <typename T, int Depth>
+consteval std::uint64_t GetVersionFingerprint();
+
+// mixes the encodings of the i-th item, which is zero if all are plain
+constexpr std::uint64_t MixEncodings(std::uint64_t h, std::size_t i,
+                                     std::uint64_t v) {
+    return v ? reflpp::_::HashInt(reflpp::_::HashInt(h, i), v) : h;
+}
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t GetElementEncodings(std::index_sequence<Is...>);
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t GetAlternativeEncodings(std::index_sequence<Is...>);
+
+// the encodings of the nested structs inside the type, e.g., the elements of
+// containers, which is zero if all are plain, so that the fingerprints are
+// the same as kFingerprint without any encoding
+template <typename T, int Depth>
+consteval std::uint64_t GetNestedEncodings() {
+    using U = RemoveCVRef<T>;
+
+    if constexpr (Depth > reflpp::_::kMaxFingerprintDepth) {
+        return 0;
+    } else if constexpr (IsAggregateStruct<U>) {
+        constexpr std::uint64_t h = GetVersionFingerprint<U, Depth>();
+        return h != kFingerprint<U> ? h : 0;
+    } else if constexpr (IsMapContainer<U>) {
+        using K = typename U::key_type;
+        using V = typename U::mapped_type;
+        constexpr std::uint64_t h =
+            MixEncodings(0, 0, GetNestedEncodings<K, Depth + 1>());
+        return MixEncodings(h, 1, GetNestedEncodings<V, Depth + 1>());
+    } else if constexpr (IsSequenceContainer<U> || IsSetContainer<U> ||
+                         IsOptional<U>) {
+        return GetNestedEncodings<typename U::value_type, Depth + 1>();
+    } else if constexpr (IsSmartPtr<U>) {
+        return GetNestedEncodings<typename U::element_type, Depth + 1>();
+    } else if constexpr (IsFixedArray<U>) {
+        using E = RemoveCVRef<decltype(std::declval<U&>()[0])>;
+        return GetNestedEncodings<E, Depth + 1>();
+    } else if constexpr (IsPair<U> || IsTuple<U>) {
+        return GetElementEncodings<U, Depth>(
+            std::make_index_sequence<std::tuple_size_v<U>>{});
+    } else if constexpr (IsVariant<U>) {
+        return GetAlternativeEncodings<U, Depth>(
+            std::make_index_sequence<std::variant_size_v<U>>{});
+    } else {
+        return 0;
+    }
+}
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t GetElementEncodings(std::index_sequence<Is...>) {
+    std::uint64_t h = 0;
+    ((h = MixEncodings(
+          h, Is, GetNestedEncodings<std::tuple_element_t<Is, T>, Depth + 1>())),
+     ...);
+    return h;
+}
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t GetAlternativeEncodings(std::index_sequence<Is...>) {
+    std::uint64_t h = 0;
+    ((h = MixEncodings(
+          h, Is,
+          GetNestedEncodings<std::variant_alternative_t<Is, T>, Depth + 1>())),
+     ...);
+    return h;
+}
+
+template <typename T, int Depth, std::size_t... Is>
+consteval auto GetFieldEncodings(std::index_sequence<Is...>) {
+    return std::array<std::uint64_t, sizeof...(Is)>{
+        GetNestedEncodings<FieldType<Is, T>, Depth + 1>()...};
+}
+
+// the encodings change the binary of fields, which are mixed into the
+// fingerprints of the versioned binary, including the ones of the nested
+// structs. notes, the recursive type is cut off at the depth
+template <typename T, int Depth = 0>
+consteval std::uint64_t GetVersionFingerprint() {
+    constexpr auto& encodings = kEncodings<T>;
+    constexpr auto nested = GetFieldEncodings<T, Depth>(
+        std::make_index_sequence<FieldsCount<T>()>{});
+
+    std::uint64_t h = kFingerprint<T>;
+    for (std::size_t i = 0; i < encodings.size(); ++i) {
+        if (encodings[i] != kPlain) {
+            h = reflpp::_::HashInt(reflpp::_::HashInt(h, i), encodings[i]);
+        }
+        h = MixEncodings(h, i, nested[i]);
+    }
+    return h;
+}
+
+template <typename T>
+consteval auto GetVersionFieldFingerprints() {
+    constexpr auto& encodings = kEncodings<T>;
+    constexpr auto nested = GetFieldEncodings<T, 0>(
+        std::make_index_sequence<FieldsCount<T>()>{});
+
+    auto fingerprints = kFieldFingerprints<T>;
+    for (std::size_t i = 0; i < encodings.size(); ++i) {
+        if (encodings[i] != kPlain) {
+            fingerprints[i] =
+                reflpp::_::HashInt(fingerprints[i], encodings[i]);
+        }
+        if (nested[i]) {
+            fingerprints[i] = reflpp::_::HashInt(fingerprints[i], nested[i]);
+        }
+    }
+    return fingerprints;
+}
+
+template <typename T>
+inline constexpr std::uint64_t kVersionFingerprint = GetVersionFingerprint<T>();
+
+template <typename T>
+inline constexpr auto kVersionFieldFingerprints =
+    GetVersionFieldFingerprints<T>();
+
+// writes the fields from the I-th one. notes, the size of each field is
+// recorded if `sizes` isn't null
+template <std::size_t I, typename Stream, typename T>
+inline void FormatFields(Stream& s, const T& t, std::size_t* sizes = nullptr) {
+    if constexpr (I < FieldsCount<T>()) {
+        constexpr auto& layout = kLayout<T>;
+        constexpr std::size_t J = layout.run_ends[I];
+
+        if constexpr (J > I + 1) {
+            constexpr std::size_t bytes =
+                layout.offsets[J - 1] + layout.sizes[J - 1] - layout.offsets[I];
+            PutBytes(s, std::addressof(GetField<I>(t)), bytes);
+            if (sizes) {
+                std::copy_n(layout.sizes.begin() + I, J - I, sizes + I);
+            }
+        } else {
+            std::size_t start = sizes ? s.size() : 0;
+            FormatField<kEncodings<T>[I]>(s, GetField<I>(t));
+            if (sizes) {
+                sizes[I] = s.size() - start;
+            }
+        }
+        FormatFields<J>(s, t, sizes);
+    }
+}
+
+}  // namespace _
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int>>
+inline void FormatBinaryValue(Stream& s, const T& t) {
+    if constexpr (IsMemcpyable<T>) {
+        _::PutBytes(s, std::addressof(t), sizeof(T));
+    } else {
+        _::FormatFields<0>(s, t);
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToBinary(Stream& s, const T& t) {
+    FormatBinaryValue(s, t);
+}
+
+// the versioned binary wraps the native binary with the header and the field
+// table, which are as follows:
+//   - the header is the fingerprint of the struct and the size of the body,
+//     both are 8-byte little-endian
+//   - the body is the same as ToBinary
+//   - the field table follows the body, which is the varint count of fields,
+//     and the fingerprint and the varint size of each field
+// the reader decodes the body directly if the fingerprint matches, otherwise
+// it matches the fields by the field table
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToVersionedBinary(Stream& s, const T& t) {
+    constexpr std::size_t N = FieldsCount<T>();
+    constexpr auto& fingerprints = _::kVersionFieldFingerprints<T>;
+
+    auto pos = s.size();
+    char header[16];
+    StoreLittleEndian(header, _::kVersionFingerprint<T>);
+    s.append(header, sizeof(header));
+
+    std::array<std::size_t, N> sizes{};
+    _::FormatFields<0>(s, t, sizes.data());
+
+    auto body = static_cast<std::uint64_t>(s.size() - pos - sizeof(header));
+    StoreLittleEndian(s.data() + pos + 8, body);
+
+    _::PutVarint(s, N);
+    for (std::size_t i = 0; i < N; ++i) {
+        StoreLittleEndian(header, fingerprints[i]);
+        s.append(header, 8);
+        _::PutVarint(s, sizes[i]);
+    }
+}
+
+}  // namespace binary
+}  // namespace reflpp
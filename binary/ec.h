@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+#define BINARY_ERROR_LIST(__)                             \
+    __(kOk, "OK")                                         \
+    __(kErrorUnexpectedTerminate, "Unexpected terminate") \
+    __(kErrorParseFailure, "Parse failure")               \
+    __(kErrorLengthOverflow, "Length overflow")           \
+    __(kErrorInvalidVariant, "Invalid variant")
+
+namespace reflpp {
+namespace binary {
+
+// clang-format off
+enum ErrorCode {
+#define __(A, B) A,
+    BINARY_ERROR_LIST(__)
+#undef __
+};
+// clang-format on
+
+struct BinaryErrorCategory : public std::error_category {
+    const char* name() const noexcept override { return "binary error"; }
+
+    // clang-format off
+    std::string message(int ec) const override {
+        switch (ec) {
+#define __(A, B) case A: return B;
+        BINARY_ERROR_LIST(__)
+#undef __
+        }
+        return "unknown error code";
+    }
+    // clang-format on
+};
+
+inline const BinaryErrorCategory error_category;
+
+inline std::error_code make_error(int ec) { return {ec, error_category}; }
+
+}  // namespace binary
+}  // namespace reflpp
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace reflpp {
+namespace _ {
+
+template <std::size_t N>
+struct UnsignedOfSize;
+
+template <>
+struct UnsignedOfSize<1> {
+    using type = std::uint8_t;
+};
+
+template <>
+struct UnsignedOfSize<2> {
+    using type = std::uint16_t;
+};
+
+template <>
+struct UnsignedOfSize<4> {
+    using type = std::uint32_t;
+};
+
+template <>
+struct UnsignedOfSize<8> {
+    using type = std::uint64_t;
+};
+
+}  // namespace _
+
+template <typename T>
+using UnsignedOfSize = typename _::UnsignedOfSize<sizeof(T)>::type;
+
+// notes, std::byteswap is only available since c++23
+template <typename T, std::enable_if_t<std::is_unsigned_v<T>, int> = 0>
+constexpr T ByteSwap(T v) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return v;
+    } else if constexpr (sizeof(T) == 2) {
+        return __builtin_bswap16(v);
+    } else if constexpr (sizeof(T) == 4) {
+        return __builtin_bswap32(v);
+    } else {
+        return __builtin_bswap64(v);
+    }
+}
+
+// the arithmetic value is stored as bytes in the given byte order. floats are
+// stored as their IEEE-754 representation
+template <std::endian Order, typename T>
+inline void StoreBytes(void* dst, T v) noexcept {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                  "Only arithmetic types are supported");
+
+    auto bits = std::bit_cast<UnsignedOfSize<T>>(v);
+    if constexpr (Order != std::endian::native) {
+        bits = ByteSwap(bits);
+    }
+    std::memcpy(dst, &bits, sizeof(bits));
+}
+
+template <std::endian Order, typename T>
+inline T LoadBytes(const void* src) noexcept {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                  "Only arithmetic types are supported");
+
+    UnsignedOfSize<T> bits;
+    std::memcpy(&bits, src, sizeof(bits));
+    if constexpr (Order != std::endian::native) {
+        bits = ByteSwap(bits);
+    }
+    return std::bit_cast<T>(bits);
+}
+
+template <typename T>
+inline void StoreBigEndian(void* dst, T v) noexcept {
+    StoreBytes<std::endian::big>(dst, v);
+}
+
+template <typename T>
+inline T LoadBigEndian(const void* src) noexcept {
+    return LoadBytes<std::endian::big, T>(src);
+}
+
+template <typename T>
+inline void StoreLittleEndian(void* dst, T v) noexcept {
+    StoreBytes<std::endian::little>(dst, v);
+}
+
+template <typename T>
+inline T LoadLittleEndian(const void* src) noexcept {
+    return LoadBytes<std::endian::little, T>(src);
+}
+
+}  // namespace reflpp
@@ -0,0 +1,709 @@
+#pragma once
+
+#include <byte_order.h>
+#include <cbor/cbor_writer.h>
+#include <cbor/ec.h>
+#include <field_name.h>
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <for_each.h>
+#include <json/utf8.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace reflpp {
+namespace cbor {
+
+namespace _ {
+
+inline const char* MajorTypeString(std::uint8_t major) {
+    switch (major) {
+        case kMajorUnsigned:
+        case kMajorNegative:
+            return "int";
+        case kMajorBytes:
+            return "bytes";
+        case kMajorText:
+            return "text";
+        case kMajorArray:
+            return "array";
+        case kMajorMap:
+            return "map";
+        case kMajorTag:
+            return "tag";
+        default:
+            return "simple";
+    }
+}
+
+// Header is the decoded initial byte and the argument
+struct Header {
+    std::uint8_t major{0};
+    std::uint8_t info{0};
+    std::uint64_t arg{0};
+
+    bool indefinite() const { return info == 31; }
+};
+
+struct Decoder {
+    Decoder(std::string_view data) : data_(data) {}
+
+    Decoder(Decoder&&) = default;
+    Decoder& operator=(Decoder&&) = default;
+
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
+
+    // notes, only the first error is kept
+    bool E(int ec) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = error_category.message(ec);
+        }
+        return false;
+    }
+
+    template <typename... Args>
+    bool E(int ec, const char* fmt, const Args&... args) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        return false;
+    }
+
+    bool IsEof() const { return cursor_ >= data_.size(); }
+    bool IsError() const { return static_cast<bool>(ec_); }
+
+    std::error_code error() const { return ec_; }
+    std::string_view detail_error() const { return detail_emsg_; }
+
+    // returns the initial byte of the next item without consuming it. notes,
+    // the semantic tags are skipped, as the tagged item is decoded as is
+    inline std::uint8_t Peek();
+
+    std::uint8_t PeekMajor() { return Peek() >> 5; }
+
+    bool IsNull() { return Peek() == kNull || Peek() == kUndefined; }
+    bool IsBreak() { return Peek() == kBreak; }
+
+    inline bool Take(std::size_t n, const char** p);
+    inline bool ReadHeader(Header* h);
+    inline bool ReadHeader(std::uint8_t major, Header* h);
+
+    inline bool ReadNull();
+    inline bool ReadBreak();
+    inline bool ReadBool(bool* v);
+    inline bool ReadFloat(double* v);
+
+    // the definite-length string is viewed in place
+    inline bool ReadView(std::uint8_t major, std::string_view* str);
+
+    // the indefinite-length string is concatenated from the chunks
+    template <typename S>
+    inline bool ReadString(std::uint8_t major, S* str);
+
+    template <typename T>
+    inline bool ReadInt(T* v);
+
+    inline bool Skip();
+
+    // returns whether there are more elements in the array or map. `n` is the
+    // remaining count of the definite-length one, and is set once the break
+    // of the indefinite-length one is read. notes, it keeps returning false
+    // after the end, so that the following items belong to the parent
+    bool HasNext(const Header& h, std::uint64_t& n) {
+        if (IsError()) return false;
+        if (!h.indefinite()) {
+            if (n == 0) return false;
+            --n;
+            return true;
+        }
+        if (n != 0) return false;
+        if (!ReadBreak()) return true;
+        n = 1;
+        return false;
+    }
+
+    bool Mismatch(const char* expect, std::uint8_t major) {
+        return E(kErrorMismatchType, "expect `{}` but got `{}`", expect,
+                 MajorTypeString(major));
+    }
+
+    std::error_code ec_;
+    std::string detail_emsg_;
+
+    std::size_t cursor_{0};
+    std::string_view data_;
+};
+
+template <typename T>
+using FieldParser = void (*)(Decoder&, T&);
+
+template <std::size_t I, typename T>
+void ParseFieldAt(Decoder& d, T& value) {
+    ParseItem(d, GetField<I>(value));
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldParsersImpl(std::index_sequence<Is...>) {
+    return std::array<FieldParser<T>, sizeof...(Is)>{&ParseFieldAt<Is, T>...};
+}
+
+// the parsers of fields, which are indexed by the field index, so that the
+// field is parsed without visiting the others
+template <typename T>
+inline constexpr auto kFieldParsers =
+    GetFieldParsersImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+void ParseItem(Decoder& d, T& value) {
+    constexpr auto& fields = ::reflpp::kFieldNames<T>;
+
+    Header h;
+    if (d.PeekMajor() == kMajorMap) {
+        if (!d.ReadHeader(kMajorMap, &h)) return;
+
+        for (auto n = h.arg; d.HasNext(h, n);) {
+            std::string_view key;
+            if (!d.ReadView(kMajorText, &key)) return;
+
+            // for compatibility, here ignore unknown fields
+            auto itr = std::find(fields.begin(), fields.end(), key);
+            if (itr == fields.end()) {
+                d.Skip();
+                continue;
+            }
+
+            kFieldParsers<T>[itr - fields.begin()](d, value);
+        }
+        return;
+    }
+
+    if (!d.ReadHeader(kMajorArray, &h)) return;
+
+    // the missing fields keep unchanged, and the extra ones are ignored
+    auto n = h.arg;
+    ForEach(value, [&d, &h, &n](auto, auto& v) {
+        if (!d.HasNext(h, n)) return;
+        ParseItem(d, v);
+    });
+    while (d.HasNext(h, n)) {
+        d.Skip();
+    }
+}
+
+template <typename T, std::enable_if_t<IsBool<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    d.ReadBool(&value);
+}
+
+template <typename T, std::enable_if_t<IsIntegral<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    d.ReadInt(&value);
+}
+
+template <typename T, std::enable_if_t<IsFloat<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    double v = 0;
+    if (d.ReadFloat(&v)) {
+        value = static_cast<T>(v);
+    }
+}
+
+template <typename T, std::enable_if_t<IsChar<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    std::string_view str;
+    if (!d.ReadView(kMajorText, &str)) return;
+
+    std::uint32_t codepoint = 0;
+    auto opt = Utf8DfaDecoder::Decode(str.data(), str.size(), &codepoint);
+    if (!opt || opt.value() != str.size()) {
+        d.E(kErrorMismatchType, "invalid char");
+        return;
+    }
+    value = codepoint;
+}
+
+template <typename T, std::enable_if_t<IsString<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    d.ReadString(kMajorText, &value);
+}
+
+// notes, the string view refers to the input buffer, which should outlive it
+template <typename T, std::enable_if_t<IsStringView<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    std::string_view str;
+    if (d.ReadView(kMajorText, &str)) {
+        value = str;
+    }
+}
+
+// notes, the byte span refers to the input buffer, which should outlive it
+template <typename T, std::enable_if_t<IsByteSpan<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = typename T::element_type;
+
+    std::string_view bytes;
+    if (d.ReadView(kMajorBytes, &bytes)) {
+        value = T(reinterpret_cast<U*>(bytes.data()), bytes.size());
+    }
+}
+
+template <typename T, std::enable_if_t<IsByteVector<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    std::string bytes;
+    if (d.ReadString(kMajorBytes, &bytes)) {
+        auto p = reinterpret_cast<const typename T::value_type*>(bytes.data());
+        value.assign(p, p + bytes.size());
+    }
+}
+
+template <typename T, std::enable_if_t<IsMapContainer<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using KeyType = typename U::key_type;
+
+    Header h;
+    if (!d.ReadHeader(kMajorMap, &h)) return;
+
+    value.clear();
+    for (auto n = h.arg; d.HasNext(h, n);) {
+        KeyType key{};
+        ParseItem(d, key);
+        ParseItem(d, value[std::move(key)]);
+    }
+}
+
+template <typename T,
+          std::enable_if_t<IsSequenceContainer<T> && !IsByteVector<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    Header h;
+    if (!d.ReadHeader(kMajorArray, &h)) return;
+
+    value.clear();
+    for (auto n = h.arg; d.HasNext(h, n);) {
+        ParseItem(d, value.emplace_back());
+    }
+}
+
+template <typename T, std::enable_if_t<IsSetContainer<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using KeyType = typename U::key_type;
+
+    Header h;
+    if (!d.ReadHeader(kMajorArray, &h)) return;
+
+    value.clear();
+    for (auto n = h.arg; d.HasNext(h, n);) {
+        KeyType v{};
+        ParseItem(d, v);
+        value.insert(std::move(v));
+    }
+}
+
+template <typename T, std::enable_if_t<IsOptional<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using ValueType = typename U::value_type;
+
+    if (d.ReadNull()) {
+        value = std::nullopt;
+    } else {
+        ValueType v{};
+        ParseItem(d, v);
+        value = std::move(v);
+    }
+}
+
+template <typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    using U = std::remove_reference_t<T>;
+    using ValueType = typename U::element_type;
+
+    if (d.ReadNull()) {
+        value = nullptr;
+    } else {
+        if constexpr (IsUniquePtr<T>) {
+            value = std::make_unique<ValueType>();
+        } else {
+            value = std::make_shared<ValueType>();
+        }
+        ParseItem(d, *value);
+    }
+}
+
+template <typename T, std::size_t... Is>
+void ParseTuple(Decoder& d, T& value, const Header& h, std::uint64_t& n,
+                std::index_sequence<Is...>) {
+    ((d.HasNext(h, n) ? ParseItem(d, std::get<Is>(value)) : void()), ...);
+}
+
+template <typename T, std::enable_if_t<IsTuple<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    constexpr std::size_t size = std::tuple_size_v<T>;
+
+    Header h;
+    if (!d.ReadHeader(kMajorArray, &h)) return;
+
+    auto n = h.arg;
+    ParseTuple(d, value, h, n, std::make_index_sequence<size>{});
+    while (d.HasNext(h, n)) {
+        d.Skip();
+    }
+}
+
+template <typename T, std::enable_if_t<IsCharArray<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    constexpr std::size_t n = sizeof(T) / sizeof(value[0]);
+
+    std::string_view str;
+    if (!d.ReadView(kMajorText, &str)) return;
+
+    if (str.size() > n) {
+        d.E(kErrorArrayOutOfRange);
+        return;
+    }
+
+    std::copy(str.begin(), str.end(), std::begin(value));
+    if (str.size() < n) {
+        value[str.size()] = '\0';
+    }
+}
+
+template <typename T, std::enable_if_t<IsNonCharArray<T>, int> = 0>
+void ParseItem(Decoder& d, T& value) {
+    constexpr std::size_t size = sizeof(T) / sizeof(value[0]);
+
+    Header h;
+    if (!d.ReadHeader(kMajorArray, &h)) return;
+
+    auto n = h.arg;
+    for (std::size_t i = 0; d.HasNext(h, n); ++i) {
+        if (i >= size) {
+            d.E(kErrorArrayOutOfRange);
+            return;
+        }
+        ParseItem(d, value[i]);
+    }
+}
+
+inline bool Decoder::Take(std::size_t n, const char** p) {
+    if (IsError()) return false;
+
+    if (data_.size() - cursor_ < n) {
+        return E(kErrorUnexpectedTerminate);
+    }
+
+    *p = data_.data() + cursor_;
+    cursor_ += n;
+    return true;
+}
+
+inline std::uint8_t Decoder::Peek() {
+    while (!IsError() && !IsEof()) {
+        auto ib = static_cast<std::uint8_t>(data_[cursor_]);
+        if ((ib >> 5) != kMajorTag) {
+            return ib;
+        }
+
+        Header h;
+        if (!ReadHeader(&h)) break;
+    }
+
+    // notes, 0x1c is reserved, which matches nothing
+    return 0x1c;
+}
+
+inline bool Decoder::ReadHeader(Header* h) {
+    const char* p = nullptr;
+    if (!Take(1, &p)) return false;
+
+    auto ib = static_cast<std::uint8_t>(*p);
+    h->major = ib >> 5;
+    h->info = ib & 0x1f;
+
+    switch (h->info) {
+        case 0 ... 23:
+            h->arg = h->info;
+            return true;
+        case 24:
+            if (!Take(1, &p)) return false;
+            h->arg = LoadBigEndian<std::uint8_t>(p);
+            return true;
+        case 25:
+            if (!Take(2, &p)) return false;
+            h->arg = LoadBigEndian<std::uint16_t>(p);
+            return true;
+        case 26:
+            if (!Take(4, &p)) return false;
+            h->arg = LoadBigEndian<std::uint32_t>(p);
+            return true;
+        case 27:
+            if (!Take(8, &p)) return false;
+            h->arg = LoadBigEndian<std::uint64_t>(p);
+            return true;
+        case 31:
+            // the indefinite length is only valid for strings, arrays and maps
+            if (h->major >= kMajorBytes && h->major <= kMajorMap) {
+                h->arg = 0;
+                return true;
+            }
+            if (h->major == kMajorSimple) {
+                return E(kErrorParseFailure, "unexpected break");
+            }
+            break;
+        default:
+            break;
+    }
+    return E(kErrorParseFailure, "invalid initial byte {:#04x}", ib);
+}
+
+inline bool Decoder::ReadHeader(std::uint8_t major, Header* h) {
+    if (PeekMajor() != major) {
+        if (!IsError() && IsEof()) {
+            return E(kErrorUnexpectedTerminate);
+        }
+        return Mismatch(MajorTypeString(major), PeekMajor());
+    }
+    return ReadHeader(h);
+}
+
+inline bool Decoder::ReadNull() {
+    if (!IsNull()) return false;
+
+    ++cursor_;
+    return true;
+}
+
+inline bool Decoder::ReadBreak() {
+    if (!IsBreak()) return false;
+
+    ++cursor_;
+    return true;
+}
+
+inline bool Decoder::ReadBool(bool* v) {
+    auto ib = Peek();
+    if (ib != kTrue && ib != kFalse) {
+        return Mismatch("bool", ib >> 5);
+    }
+
+    ++cursor_;
+    *v = ib == kTrue;
+    return true;
+}
+
+// notes, the integer is also accepted as a float
+inline bool Decoder::ReadFloat(double* v) {
+    const char* p = nullptr;
+    switch (Peek()) {
+        case kFloat16: {
+            ++cursor_;
+            if (!Take(2, &p)) return false;
+
+            // see RFC 8949 Appendix D
+            auto half = LoadBigEndian<std::uint16_t>(p);
+            int exp = (half >> 10) & 0x1f;
+            int mant = half & 0x3ff;
+            double val;
+            if (exp == 0) {
+                val = std::ldexp(mant, -24);
+            } else if (exp != 31) {
+                val = std::ldexp(mant + 1024, exp - 25);
+            } else {
+                val = mant == 0 ? INFINITY : NAN;
+            }
+            *v = half & 0x8000 ? -val : val;
+            return true;
+        }
+        case kFloat32:
+            ++cursor_;
+            if (!Take(4, &p)) return false;
+            *v = LoadBigEndian<float>(p);
+            return true;
+        case kFloat64:
+            ++cursor_;
+            if (!Take(8, &p)) return false;
+            *v = LoadBigEndian<double>(p);
+            return true;
+        default:
+            break;
+    }
+
+    auto major = PeekMajor();
+    if (major == kMajorUnsigned) {
+        std::uint64_t u = 0;
+        if (!ReadInt(&u)) return false;
+        *v = static_cast<double>(u);
+        return true;
+    } else if (major == kMajorNegative) {
+        std::int64_t i = 0;
+        if (!ReadInt(&i)) return false;
+        *v = static_cast<double>(i);
+        return true;
+    }
+    return Mismatch("float", major);
+}
+
+inline bool Decoder::ReadView(std::uint8_t major, std::string_view* str) {
+    Header h;
+    if (!ReadHeader(major, &h)) return false;
+
+    if (h.indefinite()) {
+        return E(kErrorIndefiniteLength,
+                 "indefinite-length string can't be viewed in place");
+    }
+
+    const char* p = nullptr;
+    if (h.arg > data_.size() || !Take(h.arg, &p)) {
+        return E(kErrorUnexpectedTerminate);
+    }
+
+    *str = std::string_view(p, h.arg);
+    return true;
+}
+
+template <typename S>
+inline bool Decoder::ReadString(std::uint8_t major, S* str) {
+    if (PeekMajor() == major && (Peek() & 0x1f) == 31) {
+        Header h;
+        ReadHeader(&h);
+
+        // the chunks are definite-length strings of the same major type
+        str->clear();
+        while (!IsError() && !ReadBreak()) {
+            std::string_view chunk;
+            if (!ReadView(major, &chunk)) return false;
+            str->append(chunk.begin(), chunk.end());
+        }
+        return !IsError();
+    }
+
+    std::string_view view;
+    if (!ReadView(major, &view)) return false;
+
+    str->assign(view.begin(), view.end());
+    return true;
+}
+
+template <typename T>
+inline bool Decoder::ReadInt(T* v) {
+    auto major = PeekMajor();
+    if (major != kMajorUnsigned && major != kMajorNegative) {
+        return Mismatch("int", major);
+    }
+
+    Header h;
+    if (!ReadHeader(&h)) return false;
+
+    if (h.major == kMajorUnsigned) {
+        if (!std::in_range<T>(h.arg)) {
+            return E(kErrorIntegerOverflow, "integer {} is out of range",
+                     h.arg);
+        }
+        *v = static_cast<T>(h.arg);
+        return true;
+    }
+
+    // the value is `-1 - arg`, which is out of the range of int64_t if the arg
+    // is greater than INT64_MAX
+    if constexpr (std::is_signed_v<T>) {
+        if (h.arg <= static_cast<std::uint64_t>(INT64_MAX)) {
+            auto i = -1 - static_cast<std::int64_t>(h.arg);
+            if (std::in_range<T>(i)) {
+                *v = static_cast<T>(i);
+                return true;
+            }
+        }
+    }
+    return E(kErrorIntegerOverflow, "integer -1-{} is out of range", h.arg);
+}
+
+// skips the next item, including the nested ones, without recursion
+inline bool Decoder::Skip() {
+    // the count of pending items, and the depth of indefinite containers whose
+    // break is pending
+    std::uint64_t pending = 1;
+    std::vector<std::uint64_t> indefinite;
+
+    while (pending > 0 || !indefinite.empty()) {
+        if (pending == 0) {
+            if (!ReadBreak()) {
+                if (IsError() || IsEof()) return E(kErrorUnexpectedTerminate);
+                pending = 1;
+                continue;
+            }
+            pending = indefinite.back();
+            indefinite.pop_back();
+            continue;
+        }
+        --pending;
+
+        Header h;
+        if (!ReadHeader(&h)) return false;
+
+        const char* p = nullptr;
+        switch (h.major) {
+            case kMajorBytes:
+            case kMajorText:
+                if (h.indefinite()) {
+                    indefinite.push_back(pending);
+                    pending = 0;
+                } else if (h.arg > data_.size() || !Take(h.arg, &p)) {
+                    return E(kErrorUnexpectedTerminate);
+                }
+                break;
+            case kMajorArray:
+            case kMajorMap:
+                if (h.indefinite()) {
+                    indefinite.push_back(pending);
+                    pending = 0;
+                } else {
+                    pending += h.major == kMajorArray ? h.arg : 2 * h.arg;
+                }
+                break;
+            case kMajorTag:
+                // the tagged item follows
+                ++pending;
+                break;
+            default:
+                break;
+        }
+    }
+    return !IsError();
+}
+
+}  // namespace _
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromCbor(std::string_view data, T& value,
+                         std::string* detail_emsg = nullptr) {
+    _::Decoder d(data);
+
+    _::ParseItem(d, value);
+    if (!d.IsError() && !d.IsEof()) {
+        d.E(kErrorParseFailure, "unexpected trailing bytes");
+    }
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+}  // namespace cbor
+}  // namespace reflpp
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <byte_order.h>
+#include <field_name.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace reflpp {
+namespace cbor {
+
+// the encoding of the aggregate struct, either a map keyed by the field names
+// or an array ordered by the field indices
+enum Encoding {
+    kMap,
+    kArray,
+};
+
+namespace _ {
+
+// see RFC 8949, the major type is the high-order 3 bits of the initial byte
+enum MajorType : std::uint8_t {
+    kMajorUnsigned = 0,
+    kMajorNegative = 1,
+    kMajorBytes = 2,
+    kMajorText = 3,
+    kMajorArray = 4,
+    kMajorMap = 5,
+    kMajorTag = 6,
+    kMajorSimple = 7,
+};
+
+inline constexpr std::uint8_t kFalse = 0xf4;
+inline constexpr std::uint8_t kTrue = 0xf5;
+inline constexpr std::uint8_t kNull = 0xf6;
+inline constexpr std::uint8_t kUndefined = 0xf7;
+inline constexpr std::uint8_t kFloat16 = 0xf9;
+inline constexpr std::uint8_t kFloat32 = 0xfa;
+inline constexpr std::uint8_t kFloat64 = 0xfb;
+inline constexpr std::uint8_t kBreak = 0xff;
+
+template <typename T>
+struct IsByteSpanImpl : std::false_type {};
+
+// notes, only the read-only span is decoded, which views the input buffer
+template <typename T>
+struct IsByteSpanImpl<std::span<const T>>
+    : std::bool_constant<IsByteVector<std::vector<std::remove_cv_t<T>>>> {};
+
+// Encoder is the stream with the encoding options
+template <typename Stream, Encoding E = kMap>
+class Encoder : public Stream {
+   public:
+    using value_type = typename Stream::value_type;
+    using size_type = typename Stream::size_type;
+
+    static constexpr Encoding kEncoding = E;
+
+    Encoder() = default;
+    Encoder(size_type init_cap) { Stream::reserve(init_cap); }
+
+    Encoder(Encoder&&) = default;
+    Encoder(const Encoder&) = delete;
+    Encoder& operator=(Encoder&&) = default;
+    Encoder& operator=(const Encoder&) = delete;
+
+    Stream& stream() { return *this; }
+    const Stream& stream() const { return *this; }
+};
+
+template <typename Stream>
+inline void PutByte(Stream& s, std::uint8_t b) {
+    s.push_back(static_cast<char>(b));
+}
+
+template <typename Stream, typename T>
+inline void PutTagged(Stream& s, std::uint8_t tag, T v) {
+    char buf[1 + sizeof(T)];
+    buf[0] = static_cast<char>(tag);
+    StoreBigEndian(buf + 1, v);
+    s.append(buf, sizeof(buf));
+}
+
+// the argument is encoded in the shortest form, as the deterministic encoding
+// requires. notes, all of lengths are definite
+template <typename Stream>
+inline void PutHeader(Stream& s, std::uint8_t major, std::uint64_t n) {
+    const std::uint8_t ib = major << 5;
+    if (n < 24) {
+        PutByte(s, ib | static_cast<std::uint8_t>(n));
+    } else if (n <= std::numeric_limits<std::uint8_t>::max()) {
+        PutTagged(s, ib | 24, static_cast<std::uint8_t>(n));
+    } else if (n <= std::numeric_limits<std::uint16_t>::max()) {
+        PutTagged(s, ib | 25, static_cast<std::uint16_t>(n));
+    } else if (n <= std::numeric_limits<std::uint32_t>::max()) {
+        PutTagged(s, ib | 26, static_cast<std::uint32_t>(n));
+    } else {
+        PutTagged(s, ib | 27, n);
+    }
+}
+
+template <typename Stream>
+inline void PutText(Stream& s, std::string_view str) {
+    PutHeader(s, kMajorText, str.size());
+    s.append(str.data(), str.size());
+}
+
+}  // namespace _
+
+template <typename T>
+inline constexpr bool IsByteSpan = _::IsByteSpanImpl<RemoveCVRef<T>>::value;
+
+template <typename Stream, typename T>
+inline void FormatCborValue(Stream& s, const std::optional<T>&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsMapContainer<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSequenceContainer<T> && !IsByteVector<T>, int> =
+              0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSetContainer<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsNonCharArray<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsCharArray<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T&);
+
+template <typename Stream>
+inline void FormatCborValue(Stream& s, std::nullptr_t) {
+    _::PutByte(s, _::kNull);
+}
+
+template <typename Stream>
+inline void FormatCborValue(Stream& s, bool b) {
+    _::PutByte(s, b ? _::kTrue : _::kFalse);
+}
+
+template <typename Stream>
+inline void FormatCborValue(Stream& s, char value) {
+    _::PutText(s, std::string_view(&value, 1));
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsIntegral<T>, int> = 0>
+inline void FormatCborValue(Stream& s, T value) {
+    if constexpr (std::is_signed_v<T>) {
+        if (value < 0) {
+            // the negative integer is encoded as `-1 - n`
+            auto n = static_cast<std::uint64_t>(-(value + 1));
+            _::PutHeader(s, _::kMajorNegative, n);
+            return;
+        }
+    }
+    _::PutHeader(s, _::kMajorUnsigned, static_cast<std::uint64_t>(value));
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsFloat<T>, int> = 0>
+inline void FormatCborValue(Stream& s, T value) {
+    if constexpr (std::is_same_v<T, float>) {
+        _::PutTagged(s, _::kFloat32, value);
+    } else {
+        _::PutTagged(s, _::kFloat64, static_cast<double>(value));
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsStringLike<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T& t) {
+    _::PutHeader(s, _::kMajorText, t.size());
+    s.append(t.data(), t.size());
+}
+
+// the byte vector and byte span are encoded as the byte string
+template <typename Stream, typename T,
+          std::enable_if_t<IsByteVector<T> || IsByteSpan<T>, int> = 0>
+inline void FormatCborValue(Stream& s, const T& t) {
+    _::PutHeader(s, _::kMajorBytes, t.size());
+    s.append(reinterpret_cast<const char*>(t.data()), t.size());
+}
+
+template <typename Stream, typename T>
+inline void FormatCborValue(Stream& s, const std::optional<T>& val) {
+    if (!val) {
+        _::PutByte(s, _::kNull);
+    } else {
+        FormatCborValue(s, *val);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsNonCharArray<T>, int>>
+inline void FormatCborValue(Stream& s, const T& v) {
+    _::PutHeader(s, _::kMajorArray, sizeof(T) / sizeof(v[0]));
+    for (const auto& e : v) {
+        FormatCborValue(s, e);
+    }
+}
+
+// notes, the char array is handled as a string, which ends with '\0'
+template <typename Stream, typename T, std::enable_if_t<IsCharArray<T>, int>>
+inline void FormatCborValue(Stream& s, const T& v) {
+    constexpr std::size_t n = sizeof(T) / sizeof(v[0]);
+    std::size_t len = 0;
+    while (len < n && v[len] != '\0') {
+        ++len;
+    }
+    _::PutText(s, std::string_view(std::begin(v), len));
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsMapContainer<T>, int>>
+inline void FormatCborValue(Stream& s, const T& v) {
+    _::PutHeader(s, _::kMajorMap, v.size());
+    for (const auto& [key, val] : v) {
+        FormatCborValue(s, key);
+        FormatCborValue(s, val);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsSetContainer<T>, int>>
+inline void FormatCborValue(Stream& s, const T& v) {
+    _::PutHeader(s, _::kMajorArray, v.size());
+    for (const auto& e : v) {
+        FormatCborValue(s, e);
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSequenceContainer<T> && !IsByteVector<T>, int>>
+inline void FormatCborValue(Stream& s, const T& v) {
+    _::PutHeader(s, _::kMajorArray, v.size());
+    for (const auto& e : v) {
+        FormatCborValue(s, e);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int>>
+inline void FormatCborValue(Stream& s, const T& v) {
+    if (v) {
+        FormatCborValue(s, *v);
+    } else {
+        _::PutByte(s, _::kNull);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int>>
+inline void FormatCborValue(Stream& s, const T& t) {
+    _::PutHeader(s, _::kMajorArray, std::tuple_size_v<std::decay_t<T>>);
+    ForEach(t, [&s](auto, const auto& v) { FormatCborValue(s, v); });
+}
+
+// notes, same as json, only the value of the variant is encoded
+template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int>>
+inline void FormatCborValue(Stream& s, const T& t) {
+    std::visit([&s](const auto& value) { FormatCborValue(s, value); }, t);
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int>>
+inline void FormatCborValue(Stream& s, const T& t) {
+    constexpr auto& fields = ::reflpp::kFieldNames<T>;
+
+    if constexpr (Stream::kEncoding == kMap) {
+        _::PutHeader(s, _::kMajorMap, fields.size());
+        ForEach(t, [&](auto idx, const auto& v) {
+            _::PutText(s, fields[idx]);
+            FormatCborValue(s, v);
+        });
+    } else {
+        _::PutHeader(s, _::kMajorArray, fields.size());
+        ForEach(t, [&](auto, const auto& v) { FormatCborValue(s, v); });
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToCbor(Stream& s, const T& t) {
+    FormatCborValue(s, t);
+}
+
+using MapEncoder = _::Encoder<std::string, kMap>;
+using ArrayEncoder = _::Encoder<std::string, kArray>;
+
+}  // namespace cbor
+}  // namespace reflpp
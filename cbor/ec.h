@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+#define CBOR_ERROR_LIST(__)                               \
+    __(kOk, "OK")                                         \
+    __(kErrorUnexpectedTerminate, "Unexpected terminate") \
+    __(kErrorParseFailure, "Parse failure")               \
+    __(kErrorMismatchType, "Mismatch type")               \
+    __(kErrorArrayOutOfRange, "Array out of range")       \
+    __(kErrorIntegerOverflow, "Integer overflow")         \
+    __(kErrorInvalidUtf8Char, "Invalid utf8 char")        \
+    __(kErrorIndefiniteLength, "Indefinite length")
+
+namespace reflpp {
+namespace cbor {
+
+// clang-format off
+enum ErrorCode {
+#define __(A, B) A,
+    CBOR_ERROR_LIST(__)
+#undef __
+};
+// clang-format on
+
+struct CborErrorCategory : public std::error_category {
+    const char* name() const noexcept override { return "cbor error"; }
+
+    // clang-format off
+    std::string message(int ec) const override {
+        switch (ec) {
+#define __(A, B) case A: return B;
+        CBOR_ERROR_LIST(__)
+#undef __
+        }
+        return "unknown error code";
+    }
+    // clang-format on
+};
+
+inline const CborErrorCategory error_category;
+
+inline std::error_code make_error(int ec) { return {ec, error_category}; }
+
+}  // namespace cbor
+}  // namespace reflpp
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// the structural equality and ordering, which compare the aggregate structs
+// field by field, the containers element by element, the optional and smart
+// pointers by the values, and the rest by their own operators:
+//   - the types without padding and floats are equal if and only if their
+//     bytes are equal, so that they are compared by memcmp
+//   - the ordering of bytes is only the ordering of values for the unsigned
+//     integers of one byte, or any size in big endian, so that the structs
+//     only of them are ordered by memcmp
+//   - the floats are ordered partially, and the rest are ordered strongly
+// notes, the unordered containers are only equality comparable
+namespace reflpp {
+namespace _ {
+
+template <typename T>
+inline constexpr bool IsBytewiseEqual =
+    std::has_unique_object_representations_v<T>;
+
+template <typename T>
+consteval bool IsBytewiseOrderedImpl();
+
+template <typename T, std::size_t... Is>
+consteval bool IsBytewiseOrderedStruct(std::index_sequence<Is...>) {
+    return (IsBytewiseOrderedImpl<FieldType<Is, T>>() && ...);
+}
+
+template <typename T>
+consteval bool IsBytewiseOrderedImpl() {
+    if constexpr (!IsBytewiseEqual<T>) {
+        return false;
+    } else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) {
+        return sizeof(T) == 1 || std::endian::native == std::endian::big;
+    } else if constexpr (IsArray<T>) {
+        return IsBytewiseOrderedImpl<typename T::value_type>();
+    } else if constexpr (IsAggregateStruct<T>) {
+        return IsBytewiseOrderedStruct<T>(
+            std::make_index_sequence<FieldsCount<T>()>{});
+    } else {
+        return false;
+    }
+}
+
+// whether the lexicographical order of bytes is the order of values
+template <typename T>
+inline constexpr bool IsBytewiseOrdered = IsBytewiseOrderedImpl<T>();
+
+inline std::strong_ordering CompareBytes(const void* a, const void* b,
+                                         std::size_t n) {
+    return n == 0 ? std::strong_ordering::equal
+                  : std::memcmp(a, b, n) <=> 0;
+}
+
+template <typename T>
+bool EqualValue(const T& a, const T& b);
+
+template <typename T>
+auto CompareValue(const T& a, const T& b);
+
+template <typename T, std::size_t... Is>
+bool EqualTuple(const T& a, const T& b, std::index_sequence<Is...>) {
+    return (EqualValue(std::get<Is>(a), std::get<Is>(b)) && ...);
+}
+
+template <typename T, std::size_t... Is>
+auto CompareTuple(const T& a, const T& b, std::index_sequence<Is...>) {
+    using R = std::common_comparison_category_t<decltype(CompareValue(
+        std::get<Is>(a), std::get<Is>(b)))...>;
+
+    R r = std::strong_ordering::equal;
+    (void)(((r = CompareValue(std::get<Is>(a), std::get<Is>(b))) != 0) || ...);
+    return r;
+}
+
+// the common ordering of alternatives, which is only used in decltype
+template <typename... Ts>
+auto VariantOrderingOf(const std::variant<Ts...>*)
+    -> std::common_comparison_category_t<decltype(CompareValue(
+        std::declval<const Ts&>(), std::declval<const Ts&>()))...>;
+
+template <typename T>
+bool EqualValue(const T& a, const T& b) {
+    if constexpr (IsBytewiseEqual<T>) {
+        return std::memcmp(std::addressof(a), std::addressof(b),
+                           sizeof(T)) == 0;
+    } else if constexpr (IsFloat<T> || IsStringLike<T>) {
+        return a == b;
+    } else if constexpr (IsOptional<T> || IsSmartPtr<T>) {
+        return a && b ? EqualValue(*a, *b) : !a == !b;
+    } else if constexpr (IsVariant<T>) {
+        return a.index() == b.index() &&
+               std::visit(
+                   [](const auto& x, const auto& y) {
+                       if constexpr (std::is_same_v<decltype(x), decltype(y)>) {
+                           return EqualValue(x, y);
+                       } else {
+                           return false;
+                       }
+                   },
+                   a, b);
+    } else if constexpr (IsPair<T> || IsTuple<T>) {
+        return EqualTuple(a, b,
+                          std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else if constexpr (IsUnorderedContainer<T> && IsMapContainer<T> &&
+                         !IsTemplateOf<std::unordered_multimap, T>) {
+        // notes, the keys are compared by the key_equal of the container
+        return a.size() == b.size() &&
+               std::all_of(a.begin(), a.end(), [&b](const auto& e) {
+                   auto it = b.find(e.first);
+                   return it != b.end() && EqualValue(e.second, it->second);
+               });
+    } else if constexpr (IsUnorderedContainer<T>) {
+        return a == b;
+    } else if constexpr (IsContainer<T>) {
+        using E = typename T::value_type;
+        if (a.size() != b.size()) {
+            return false;
+        }
+        if constexpr (IsContiguousContainer<T> && IsBytewiseEqual<E>) {
+            return a.empty() ||
+                   std::memcmp(a.data(), b.data(), a.size() * sizeof(E)) == 0;
+        } else {
+            return std::equal(a.begin(), a.end(), b.begin(),
+                              [](const E& x, const E& y) {
+                                  return EqualValue(x, y);
+                              });
+        }
+    } else if constexpr (IsAggregateStruct<T>) {
+        return VisitFields(a, [&b](const auto&... xs) {
+            return VisitFields(b, [&xs...](const auto&... ys) {
+                return (EqualValue(xs, ys) && ...);
+            });
+        });
+    } else {
+        return a == b;
+    }
+}
+
+template <typename T>
+auto CompareValue(const T& a, const T& b) {
+    if constexpr (IsBytewiseOrdered<T>) {
+        return CompareBytes(std::addressof(a), std::addressof(b), sizeof(T));
+    } else if constexpr (IsOptional<T> || IsSmartPtr<T>) {
+        using R = decltype(CompareValue(*a, *b));
+        return a && b ? CompareValue(*a, *b) : R(!!a <=> !!b);
+    } else if constexpr (IsVariant<T>) {
+        using R = decltype(VariantOrderingOf(&a));
+        if (a.index() != b.index()) {
+            return R(a.index() <=> b.index());
+        }
+        return std::visit(
+            [](const auto& x, const auto& y) -> R {
+                if constexpr (std::is_same_v<decltype(x), decltype(y)>) {
+                    return CompareValue(x, y);
+                } else {
+                    return std::strong_ordering::equal;
+                }
+            },
+            a, b);
+    } else if constexpr (IsPair<T> || IsTuple<T>) {
+        return CompareTuple(a, b,
+                            std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else if constexpr (IsStringLike<T>) {
+        return a <=> b;
+    } else if constexpr (IsContainer<T>) {
+        static_assert(!IsUnorderedContainer<T>,
+                      "The unordered container is not ordered");
+
+        using E = typename T::value_type;
+        if constexpr (IsContiguousContainer<T> && IsBytewiseOrdered<E>) {
+            const std::size_t n = std::min(a.size(), b.size());
+            auto r = CompareBytes(a.data(), b.data(), n * sizeof(E));
+            return r != 0 ? r : a.size() <=> b.size();
+        } else {
+            using R = decltype(CompareValue(std::declval<const E&>(),
+                                            std::declval<const E&>()));
+            auto x = a.begin();
+            auto y = b.begin();
+            for (; x != a.end() && y != b.end(); ++x, ++y) {
+                R r = CompareValue(*x, *y);
+                if (r != 0) return r;
+            }
+            return R(a.size() <=> b.size());
+        }
+    } else if constexpr (IsAggregateStruct<T>) {
+        return VisitFields(a, [&b](const auto&... xs) {
+            return VisitFields(b, [&xs...](const auto&... ys) {
+                using R = std::common_comparison_category_t<decltype(
+                    CompareValue(xs, ys))...>;
+
+                R r = std::strong_ordering::equal;
+                (void)(((r = CompareValue(xs, ys)) != 0) || ...);
+                return r;
+            });
+        });
+    } else {
+        return a <=> b;
+    }
+}
+
+}  // namespace _
+
+// returns the three-way comparison of values, which is
+// std::partial_ordering if there are floats, otherwise std::strong_ordering
+template <typename T>
+auto Compare(const T& a, const T& b) {
+    return _::CompareValue(a, b);
+}
+
+// the structural equality, e.g.,
+//   std::unordered_map<Key, Value, reflpp::Hash<Key>, reflpp::Equal<Key>>
+template <typename T>
+struct Equal {
+    bool operator()(const T& a, const T& b) const {
+        return _::EqualValue(a, b);
+    }
+};
+
+// the structural ordering, e.g., std::sort(v.begin(), v.end(), Less<T>{})
+template <typename T>
+struct Less {
+    bool operator()(const T& a, const T& b) const {
+        return _::CompareValue(a, b) < 0;
+    }
+};
+
+}  // namespace reflpp
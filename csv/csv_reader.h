@@ -0,0 +1,451 @@
+#pragma once
+
+#include <csv/csv_writer.h>
+#include <csv/ec.h>
+#include <field_name.h>
+#include <fields_count.h>
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace reflpp {
+namespace csv {
+
+namespace _ {
+
+// returns the position of the first byte in [pos, end), which is one of the
+// given bytes, or end if not found. notes, the bytes are compared by 32 or 16
+// at once if avx2 or sse2 is enabled
+inline std::size_t FindAny(const char* p, std::size_t pos, std::size_t end,
+                           char a, char b, char c) {
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c);
+    for (; pos + 32 <= end; pos += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + pos));
+        auto eq = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)),
+            _mm256_cmpeq_epi8(v, vc));
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+        if (mask != 0) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    for (; pos + 16 <= end; pos += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + pos));
+        auto eq = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)),
+            _mm_cmpeq_epi8(v, vc));
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+        if (mask != 0) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+#endif
+
+    for (; pos < end; ++pos) {
+        if (p[pos] == a || p[pos] == b || p[pos] == c) break;
+    }
+    return pos;
+}
+
+struct Field {
+    std::string_view text;
+    bool quoted{false};
+};
+
+struct Reader {
+    // the reader starts at the cursor, and stops at the end of data
+    Reader(std::string_view data, std::size_t cursor, char delimiter)
+        : cursor_(cursor), delimiter_(delimiter), data_(data) {}
+
+    Reader(Reader&&) = default;
+    Reader& operator=(Reader&&) = default;
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // notes, only the first error is kept
+    bool E(int ec) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = error_category.message(ec);
+        }
+        return false;
+    }
+
+    template <typename... Args>
+    bool E(int ec, const char* fmt, const Args&... args) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        return false;
+    }
+
+    bool IsEof() const { return cursor_ >= data_.size(); }
+    bool IsError() const { return static_cast<bool>(ec_); }
+
+    std::error_code error() const { return ec_; }
+    std::string_view detail_error() const { return detail_emsg_; }
+
+    bool IsEndOfLine() const {
+        return IsEof() || data_[cursor_] == '\n' || data_[cursor_] == '\r';
+    }
+
+    void SkipLine() {
+        if (!IsEof() && data_[cursor_] == '\r') ++cursor_;
+        if (!IsEof() && data_[cursor_] == '\n') ++cursor_;
+    }
+
+    // reads the field, and `last` is set if it's the last field of the row.
+    // notes, the text of the quoted field with the escaped quotes refers to
+    // the scratch buffer, which is valid until the next field
+    bool ReadField(Field* field, bool* last) {
+        if (IsError()) return false;
+
+        field->quoted = !IsEof() && data_[cursor_] == '"';
+        if (field->quoted) {
+            if (!ReadQuoted(field)) return false;
+        } else {
+            auto pos = FindAny(data_.data(), cursor_, data_.size(), delimiter_,
+                               '\n', '\r');
+            field->text = data_.substr(cursor_, pos - cursor_);
+            cursor_ = pos;
+        }
+
+        *last = IsEndOfLine();
+        if (*last) {
+            SkipLine();
+        } else if (data_[cursor_++] != delimiter_) {
+            return E(kErrorParseFailure,
+                     "unexpected `{}` after the quoted field at offset {}",
+                     data_[cursor_ - 1], cursor_ - 1);
+        }
+        return true;
+    }
+
+    bool ReadQuoted(Field* field) {
+        const std::size_t start = ++cursor_;
+        bool escaped = false;
+
+        for (;;) {
+            const void* quote = std::memchr(data_.data() + cursor_, '"',
+                                            data_.size() - cursor_);
+            if (!quote) {
+                return E(kErrorUnexpectedTerminate,
+                         "unterminated quote at offset {}", start - 1);
+            }
+
+            std::size_t pos = static_cast<const char*>(quote) - data_.data();
+            if (!escaped) {
+                scratch_.clear();
+            }
+
+            // the doubled quote is the escaped one
+            if (pos + 1 < data_.size() && data_[pos + 1] == '"') {
+                scratch_.append(data_.substr(cursor_, pos + 1 - cursor_));
+                cursor_ = pos + 2;
+                escaped = true;
+                continue;
+            }
+
+            if (escaped) {
+                scratch_.append(data_.substr(cursor_, pos - cursor_));
+                field->text = scratch_;
+            } else {
+                field->text = data_.substr(start, pos - start);
+            }
+            cursor_ = pos + 1;
+            return true;
+        }
+    }
+
+    std::error_code ec_;
+    std::string detail_emsg_;
+
+    std::size_t cursor_{0};
+    char delimiter_;
+    std::string_view data_;
+    std::string scratch_;
+};
+
+template <typename T>
+bool ParseNumber(Reader& r, std::string_view text, T& value) {
+    auto last = text.data() + text.size();
+    auto res = std::from_chars(text.data(), last, value);
+    if (res.ec != std::errc() || res.ptr != last) {
+        return r.E(kErrorMismatchType, "expect `num` but got `{}`", text);
+    }
+    return true;
+}
+
+template <typename T>
+bool ParseValue(Reader& r, const Field& field, T& value) {
+    static_assert(IsColumnType<T>, "Only the flat struct is supported");
+
+    const std::string_view text = field.text;
+    if constexpr (IsBool<T>) {
+        if (text == "true" || text == "1") {
+            value = true;
+        } else if (text == "false" || text == "0") {
+            value = false;
+        } else {
+            return r.E(kErrorMismatchType, "expect `bool` but got `{}`", text);
+        }
+    } else if constexpr (IsChar<T>) {
+        if (text.size() != 1) {
+            return r.E(kErrorMismatchType, "expect `char` but got `{}`", text);
+        }
+        value = text[0];
+    } else if constexpr (IsEnum<T>) {
+        std::underlying_type_t<T> v{};
+        if (!ParseNumber(r, text, v)) return false;
+        value = static_cast<T>(v);
+    } else if constexpr (IsNumeric<T>) {
+        return ParseNumber(r, text, value);
+    } else {
+        value.assign(text.data(), text.size());
+    }
+    return true;
+}
+
+// notes, the empty field without quotes is the empty optional
+template <typename T>
+bool ParseField(Reader& r, const Field& field, T& value) {
+    if constexpr (IsOptional<T>) {
+        if (field.text.empty() && !field.quoted) {
+            value.reset();
+            return true;
+        }
+        return ParseValue(r, field, value.emplace());
+    } else {
+        return ParseValue(r, field, value);
+    }
+}
+
+template <typename T>
+using Setter = bool (*)(Reader&, const Field&, T&);
+
+template <std::size_t I, typename T>
+bool SetField(Reader& r, const Field& field, T& row) {
+    return ParseField(r, field, GetField<I>(row));
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetSettersImpl(std::index_sequence<Is...>) {
+    return std::array<Setter<T>, sizeof...(Is)>{&SetField<Is, T>...};
+}
+
+// the setters of fields, which are indexed by the field index
+template <typename T>
+inline constexpr auto kSetters =
+    GetSettersImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+// the field index of each column, or -1 if the column is unknown
+using Mapping = std::vector<int>;
+
+// notes, the unknown columns are skipped, and the missing fields keep the
+// default values
+template <typename T>
+bool ReadHeader(Reader& r, Mapping& mapping) {
+    constexpr auto& names = kFieldNames<T>;
+
+    bool last = false;
+    while (!last) {
+        Field field;
+        if (!r.ReadField(&field, &last)) return false;
+
+        auto it = std::find(names.begin(), names.end(), field.text);
+        mapping.push_back(it == names.end() ? -1 : it - names.begin());
+    }
+    return true;
+}
+
+// notes, the blank lines are skipped, unless there is only one column, in
+// which case the blank line is the empty field
+template <typename T>
+void ParseRows(Reader& r, const Mapping& mapping, std::vector<T>& rows) {
+    constexpr auto& setters = kSetters<T>;
+
+    while (!r.IsEof() && !r.IsError()) {
+        if (mapping.size() != 1 && r.IsEndOfLine()) {
+            r.SkipLine();
+            continue;
+        }
+
+        const std::size_t start = r.cursor_;
+        T& row = rows.emplace_back();
+
+        std::size_t col = 0;
+        for (bool last = false; !last; ++col) {
+            Field field;
+            if (!r.ReadField(&field, &last)) return;
+
+            if (col < mapping.size() && mapping[col] >= 0) {
+                if (!setters[mapping[col]](r, field, row)) return;
+            }
+        }
+
+        if (col != mapping.size()) {
+            r.E(kErrorColumnCount, "expect {} columns but got {} at offset {}",
+                mapping.size(), col, start);
+            return;
+        }
+    }
+}
+
+// returns the start of the first row after the position. notes, the position
+// is in the quoted field if the count of quotes ahead of it is odd, as the
+// escaped quotes are doubled
+inline std::size_t FindRowStart(std::string_view data, std::size_t pos,
+                                bool quoted) {
+    for (; pos < data.size(); ++pos) {
+        if (data[pos] == '"') {
+            quoted = !quoted;
+        } else if (data[pos] == '\n' && !quoted) {
+            return pos + 1;
+        }
+    }
+    return data.size();
+}
+
+// the rows are split into chunks at the row boundaries, which are parsed by
+// multiple threads. notes, the first chunk is parsed by the caller thread
+template <typename T>
+void ParseRowsParallel(Reader& r, const Mapping& mapping,
+                       std::vector<T>& rows, std::size_t chunks) {
+    const std::string_view data = r.data_;
+    const std::size_t begin = r.cursor_;
+    const std::size_t size = data.size() - begin;
+
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t i = 0; i <= chunks; ++i) {
+        bounds[i] = begin + size * i / chunks;
+    }
+
+    auto count_quotes = [data, &bounds](std::size_t i) {
+        return static_cast<std::size_t>(std::count(
+            data.begin() + bounds[i], data.begin() + bounds[i + 1], '"'));
+    };
+
+    std::vector<std::future<std::size_t>> counts;
+    for (std::size_t i = 1; i < chunks; ++i) {
+        counts.emplace_back(std::async(std::launch::async, count_quotes, i));
+    }
+
+    // the quotes ahead of each bound determine whether it's quoted
+    std::vector<std::size_t> starts(chunks + 1, data.size());
+    starts[0] = begin;
+    std::size_t quotes = count_quotes(0);
+    for (std::size_t i = 1; i < chunks; ++i) {
+        starts[i] = std::max(starts[i - 1],
+                             FindRowStart(data, bounds[i], quotes % 2 == 1));
+        quotes += counts[i - 1].get();
+    }
+
+    std::vector<Reader> readers;
+    std::vector<std::vector<T>> parts(chunks);
+    for (std::size_t i = 0; i < chunks; ++i) {
+        readers.emplace_back(data.substr(0, starts[i + 1]), starts[i],
+                             r.delimiter_);
+    }
+
+    auto parse_chunk = [&readers, &mapping, &parts](std::size_t i) {
+        ParseRows(readers[i], mapping, parts[i]);
+    };
+
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 1; i < chunks; ++i) {
+        futures.emplace_back(std::async(std::launch::async, parse_chunk, i));
+    }
+    parse_chunk(0);
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    std::size_t total = rows.size();
+    for (std::size_t i = 0; i < chunks; ++i) {
+        if (readers[i].IsError()) {
+            r.E(readers[i].error().value(), "{}", readers[i].detail_error());
+            return;
+        }
+        total += parts[i].size();
+    }
+
+    rows.reserve(total);
+    for (auto& part : parts) {
+        std::move(part.begin(), part.end(), std::back_inserter(rows));
+    }
+    r.cursor_ = data.size();
+}
+
+}  // namespace _
+
+// reads the rows, which are appended to the vector. the columns are matched
+// to the fields by the header if any, otherwise by the order. notes, if the
+// input is parsed by multiple threads, the quotes should only appear in the
+// quoted fields, which is required by rfc 4180
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromCsv(std::string_view csv, std::vector<T>& rows,
+                        std::string* detail_emsg = nullptr,
+                        const CsvOptions& opts = {}) {
+    // skips the utf-8 bom
+    std::size_t cursor = csv.starts_with("\xEF\xBB\xBF") ? 3 : 0;
+    _::Reader r(csv, cursor, opts.delimiter);
+
+    _::Mapping mapping;
+    if (opts.header) {
+        _::ReadHeader<T>(r, mapping);
+    } else {
+        for (std::size_t i = 0; i < FieldsCount<T>(); ++i) {
+            mapping.push_back(static_cast<int>(i));
+        }
+    }
+
+    const std::size_t min_chunk_size =
+        std::max<std::size_t>(1, opts.min_chunk_size);
+    const std::size_t chunks =
+        std::min(opts.threads, (csv.size() - r.cursor_) / min_chunk_size);
+    if (r.IsError()) {
+        // the header is malformed
+    } else if (chunks < 2) {
+        _::ParseRows(r, mapping, rows);
+    } else {
+        _::ParseRowsParallel(r, mapping, rows, chunks);
+    }
+
+    if (detail_emsg && r.IsError()) {
+        *detail_emsg = r.detail_error();
+    }
+
+    return r.error();
+}
+
+}  // namespace csv
+}  // namespace reflpp
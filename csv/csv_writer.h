@@ -0,0 +1,137 @@
+#pragma once
+
+#include <field_name.h>
+#include <fields_count.h>
+#include <fmt/format.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// the rows of the flat struct are written as csv, see rfc 4180. the header is
+// the field names, and each field is a column:
+//   - bool is `true` or `false`, chars are one-character strings
+//   - numbers are the shortest round-trip representation, enums are numbers
+//   - strings are quoted if they contain the delimiter, quotes or newlines,
+//     and the quotes are doubled
+//   - the empty optional is the empty field, and the empty string in the
+//     optional is quoted, so that they are distinguished
+// the rows are terminated by `\n`
+namespace reflpp {
+namespace csv {
+
+struct CsvOptions {
+    char delimiter = ',';
+
+    // whether the first row is the field names
+    bool header = true;
+
+    // the number of threads to parse, including the caller thread
+    std::size_t threads = 1;
+
+    // the input is split only if every chunk gets at least so many bytes.
+    // notes, the threads scan the input twice, i.e., the quotes are counted
+    // to find the row boundaries before the rows are parsed
+    std::size_t min_chunk_size = 1 << 20;
+};
+
+namespace _ {
+
+template <typename T>
+inline constexpr bool IsColumnType =
+    IsBool<T> || IsNumeric<T> || IsChar<T> || IsEnum<T> || IsString<T>;
+
+template <typename Stream>
+inline void PutString(Stream& s, std::string_view str, char delimiter,
+                      bool force_quote = false) {
+    auto special = [delimiter](char ch) {
+        return ch == delimiter || ch == '"' || ch == '\n' || ch == '\r';
+    };
+
+    if (!force_quote && std::none_of(str.begin(), str.end(), special)) {
+        s.append(str);
+        return;
+    }
+
+    s.push_back('"');
+    for (std::size_t pos = 0;;) {
+        auto quote = str.find('"', pos);
+        s.append(str.substr(pos, quote - pos));
+        if (quote == std::string_view::npos) break;
+
+        s.append("\"\"");
+        pos = quote + 1;
+    }
+    s.push_back('"');
+}
+
+template <typename Stream, typename T>
+inline void PutValue(Stream& s, const T& v, char delimiter,
+                     bool force_quote = false) {
+    static_assert(IsColumnType<T>, "Only the flat struct is supported");
+
+    if constexpr (IsBool<T>) {
+        s.append(v ? "true" : "false");
+    } else if constexpr (IsChar<T>) {
+        PutString(s, std::string_view(&v, 1), delimiter);
+    } else if constexpr (IsEnum<T>) {
+        using U = std::underlying_type_t<T>;
+        fmt::format_to(std::back_inserter(s), "{}", static_cast<U>(v));
+    } else if constexpr (IsNumeric<T>) {
+        fmt::format_to(std::back_inserter(s), "{}", v);
+    } else {
+        PutString(s, v, delimiter, force_quote);
+    }
+}
+
+template <typename Stream, typename T>
+inline void PutField(Stream& s, const T& v, char delimiter) {
+    if constexpr (IsOptional<T>) {
+        if (!v) return;
+
+        bool force_quote = false;
+        if constexpr (IsString<ValueOf<T>>) {
+            force_quote = v->empty();
+        }
+        PutValue(s, *v, delimiter, force_quote);
+    } else {
+        PutValue(s, v, delimiter);
+    }
+}
+
+}  // namespace _
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToCsv(Stream& s, const std::vector<T>& rows,
+                  const CsvOptions& opts = {}) {
+    constexpr auto& names = kFieldNames<T>;
+    const char delimiter = opts.delimiter;
+
+    if (opts.header) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (i > 0) s.push_back(delimiter);
+            _::PutString(s, names[i], delimiter);
+        }
+        s.push_back('\n');
+    }
+
+    for (const auto& row : rows) {
+        ForEach(row, [&s, delimiter](auto idx, const auto& v) {
+            if constexpr (decltype(idx)::value > 0) {
+                s.push_back(delimiter);
+            }
+            _::PutField(s, v, delimiter);
+        });
+        s.push_back('\n');
+    }
+}
+
+}  // namespace csv
+}  // namespace reflpp
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+#define CSV_ERROR_LIST(__)                                \
+    __(kOk, "OK")                                         \
+    __(kErrorUnexpectedTerminate, "Unexpected terminate") \
+    __(kErrorParseFailure, "Parse failure")               \
+    __(kErrorMismatchType, "Mismatch type")               \
+    __(kErrorColumnCount, "Column count mismatch")
+
+namespace reflpp {
+namespace csv {
+
+// clang-format off
+enum ErrorCode {
+#define __(A, B) A,
+    CSV_ERROR_LIST(__)
+#undef __
+};
+// clang-format on
+
+struct CsvErrorCategory : public std::error_category {
+    const char* name() const noexcept override { return "csv error"; }
+
+    // clang-format off
+    std::string message(int ec) const override {
+        switch (ec) {
+#define __(A, B) case A: return B;
+        CSV_ERROR_LIST(__)
+#undef __
+        }
+        return "unknown error code";
+    }
+    // clang-format on
+};
+
+inline const CsvErrorCategory error_category;
+
+inline std::error_code make_error(int ec) { return {ec, error_category}; }
+
+}  // namespace csv
+}  // namespace reflpp
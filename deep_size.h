@@ -0,0 +1,224 @@
+#pragma once
+
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// the memory footprint of the object, i.e., the inline bytes of the object
+// itself, and the heap bytes and allocations owned by it recursively.
+// notes, the heap bytes are estimated by the node layouts of the common
+// standard libraries, and exclude the overhead of the allocator. the objects
+// shared by std::shared_ptr are counted by each owner
+namespace reflpp {
+
+struct MemoryUsage {
+    std::size_t inline_bytes{0};
+    std::size_t heap_bytes{0};
+    std::size_t allocations{0};
+
+    std::size_t total() const { return inline_bytes + heap_bytes; }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        inline_bytes += other.inline_bytes;
+        heap_bytes += other.heap_bytes;
+        allocations += other.allocations;
+        return *this;
+    }
+};
+
+namespace _ {
+
+// the nodes of the red-black tree have the color and three pointers
+inline constexpr std::size_t kTreeNodeHeader = 4 * sizeof(void*);
+inline constexpr std::size_t kListNodeHeader = 2 * sizeof(void*);
+inline constexpr std::size_t kForwardListNodeHeader = sizeof(void*);
+// the next pointer, and the cached hash code, see HashNodeHeader
+inline constexpr std::size_t kHashNodeHeader = sizeof(void*);
+// the use and weak counts, and the vptr
+inline constexpr std::size_t kSharedControlBlock =
+    2 * sizeof(int) + sizeof(void*);
+// the size of blocks of std::deque
+inline constexpr std::size_t kDequeBlockSize = 512;
+
+// notes, the trivially copyable types don't own any memory, so that the
+// elements of them are not visited
+template <typename T>
+inline constexpr bool IsHeapFree =
+    std::is_trivially_copyable_v<T> || IsStringView<T>;
+
+template <typename T, typename = void>
+struct HasCapacity : std::false_type {};
+
+template <typename T>
+struct HasCapacity<
+    T, std::void_t<decltype(std::declval<const T&>().capacity())>>
+    : std::true_type {};
+
+// the hash code is cached in the nodes unless the key is cheap to hash
+template <typename T>
+constexpr std::size_t HashNodeHeader() {
+    using K = typename T::key_type;
+    return kHashNodeHeader +
+           (std::is_arithmetic_v<K> || IsEnum<K> ? 0 : sizeof(std::size_t));
+}
+
+constexpr std::size_t NodeSize(std::size_t header, std::size_t size,
+                               std::size_t align) {
+    return (header + align - 1) / align * align + size;
+}
+
+template <typename T>
+void AddHeapUsage(MemoryUsage& usage, const T& v);
+
+inline void AddHeapBytes(MemoryUsage& usage, std::size_t bytes) {
+    usage.heap_bytes += bytes;
+    usage.allocations += bytes > 0 ? 1 : 0;
+}
+
+template <typename T>
+void AddElementsUsage(MemoryUsage& usage, const T& v) {
+    if constexpr (!IsHeapFree<typename T::value_type>) {
+        for (const auto& e : v) {
+            AddHeapUsage(usage, e);
+        }
+    }
+}
+
+template <typename T, std::size_t... Is>
+void AddTupleUsage(MemoryUsage& usage, const T& v, std::index_sequence<Is...>) {
+    (AddHeapUsage(usage, std::get<Is>(v)), ...);
+}
+
+template <typename T>
+void AddHeapUsage(MemoryUsage& usage, const T& v) {
+    if constexpr (IsHeapFree<T>) {
+        return;
+    } else if constexpr (IsString<T>) {
+        // notes, the short string is stored inside the object
+        auto* begin = reinterpret_cast<const char*>(std::addressof(v));
+        auto* data = reinterpret_cast<const char*>(v.data());
+        if (data < begin || data >= begin + sizeof(T)) {
+            AddHeapBytes(usage,
+                         (v.capacity() + 1) * sizeof(typename T::value_type));
+        }
+    } else if constexpr (IsOptional<T>) {
+        if (v) AddHeapUsage(usage, *v);
+    } else if constexpr (IsVariant<T>) {
+        std::visit([&usage](const auto& alt) { AddHeapUsage(usage, alt); }, v);
+    } else if constexpr (IsPair<T> || IsTuple<T>) {
+        AddTupleUsage(usage, v,
+                      std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else if constexpr (IsSmartPtr<T>) {
+        using E = typename T::element_type;
+        if (!v) return;
+
+        // notes, the length of the array is unknown, and the object of
+        // std::shared_ptr is assumed to follow the control block, i.e., it is
+        // made by std::make_shared
+        std::size_t bytes = std::is_array_v<E> ? 0 : sizeof(E);
+        if constexpr (IsSharedPtr<T>) {
+            bytes = NodeSize(kSharedControlBlock, bytes, alignof(E));
+            bytes = NodeSize(bytes, 0, alignof(void*));
+        }
+        usage.heap_bytes += bytes;
+        usage.allocations += 1;
+        if constexpr (!std::is_array_v<E>) {
+            AddHeapUsage(usage, *v);
+        }
+    } else if constexpr (IsCArray<T> || IsArray<T>) {
+        for (const auto& e : v) {
+            AddHeapUsage(usage, e);
+        }
+    } else if constexpr (IsContiguousContainer<T> && HasCapacity<T>::value) {
+        using E = typename T::value_type;
+        AddHeapBytes(usage, v.capacity() * sizeof(E));
+        AddElementsUsage(usage, v);
+    } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+        AddHeapBytes(usage, v.capacity() / 8);
+    } else if constexpr (IsTemplateOf<std::deque, T>) {
+        using E = typename T::value_type;
+        constexpr std::size_t kPerBlock =
+            sizeof(E) < kDequeBlockSize ? kDequeBlockSize / sizeof(E) : 1;
+
+        // the blocks, and the map of blocks which has at least 8 slots
+        const std::size_t blocks = v.size() / kPerBlock + 1;
+        const std::size_t slots = std::max<std::size_t>(8, blocks + 2);
+        usage.heap_bytes += blocks * kPerBlock * sizeof(E);
+        usage.heap_bytes += slots * sizeof(void*);
+        usage.allocations += blocks + 1;
+        AddElementsUsage(usage, v);
+    } else if constexpr (IsUnorderedContainer<T>) {
+        using E = typename T::value_type;
+        const std::size_t node =
+            NodeSize(HashNodeHeader<T>(), sizeof(E), alignof(E));
+        usage.heap_bytes += v.size() * node;
+        usage.allocations += v.size();
+        AddHeapBytes(usage, v.bucket_count() * sizeof(void*));
+        AddElementsUsage(usage, v);
+    } else if constexpr (IsContainer<T> ||
+                         IsTemplateOf<std::forward_list, T>) {
+        using E = typename T::value_type;
+        std::size_t header = kTreeNodeHeader;
+        if constexpr (IsTemplateOf<std::list, T>) {
+            header = kListNodeHeader;
+        } else if constexpr (IsTemplateOf<std::forward_list, T>) {
+            header = kForwardListNodeHeader;
+        }
+
+        // notes, std::forward_list has no size()
+        const std::size_t n = std::distance(v.begin(), v.end());
+        usage.heap_bytes += n * NodeSize(header, sizeof(E), alignof(E));
+        usage.allocations += n;
+        AddElementsUsage(usage, v);
+    } else if constexpr (IsAggregateStruct<T>) {
+        VisitFields(v, [&usage](const auto&... fields) {
+            (AddHeapUsage(usage, fields), ...);
+        });
+    } else {
+        static_assert(!sizeof(T), "Unsupported type");
+    }
+}
+
+}  // namespace _
+
+// returns the memory footprint of the value, e.g.,
+//   auto usage = DeepSize(cache);
+//   std::cout << usage.total() << " bytes in " << usage.allocations;
+template <typename T>
+MemoryUsage DeepSize(const T& v) {
+    MemoryUsage usage;
+    usage.inline_bytes = sizeof(T);
+    _::AddHeapUsage(usage, v);
+    return usage;
+}
+
+// returns the memory footprint of each field with its name, whose inline bytes
+// are the size of the field. notes, the padding bytes are not counted
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+auto DeepSizeByField(const T& obj) {
+    constexpr auto& names = kFieldNames<T>;
+
+    std::array<std::pair<std::string_view, MemoryUsage>, names.size()> sizes;
+    ForEach(obj, [&sizes](auto idx, const auto& field) {
+        sizes[idx] = {names[idx], DeepSize(field)};
+    });
+    return sizes;
+}
+
+}  // namespace reflpp
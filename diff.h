@@ -0,0 +1,329 @@
+#pragma once
+
+#include <binary/binary_reader.h>
+#include <binary/binary_writer.h>
+#include <binary/ec.h>
+#include <compare.h>
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <json/json_writer.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// the patch is the list of changed leaf fields between two objects. the
+// nested aggregate structs are compared field by field, and the rest, e.g.,
+// containers and optionals, are the leaves, which are replaced as a whole.
+// the patch is encoded in two ways:
+//   - the binary patch is the varint count of changes, and each change is
+//     the varint length of path, the varint field indexes, and the new value
+//     in the binary codec prefixed with its varint size
+//   - the json merge patch, which only has the changed fields, and is applied
+//     in place by json::FromJson, since the absent fields are kept.
+//     notes, it isn't the rfc 7396 one, since the changed leaves replace the
+//     old values as a whole, e.g., the removed keys of the map aren't null,
+//     but they are gone after FromJson, which clears the map first
+namespace reflpp {
+
+// the path is the field indexes from the root, and the value is encoded by
+// the binary codec
+struct FieldChange {
+    std::vector<std::uint32_t> path;
+    std::string value;
+};
+
+template <typename T>
+struct Patch {
+    // notes, the changes are in the order of fields
+    std::vector<FieldChange> changes;
+
+    bool empty() const { return changes.empty(); }
+    std::size_t size() const { return changes.size(); }
+};
+
+namespace _ {
+
+// calls the function with the i-th field, which is dispatched by the table
+template <typename T, typename F, std::size_t... Is>
+void VisitFieldAt(T& obj, std::size_t i, F& f, std::index_sequence<Is...>) {
+    using Visitor = void (*)(T&, F&);
+    static constexpr Visitor kVisitors[] = {
+        [](T& o, F& fn) { fn(GetField<Is>(o)); }...};
+    kVisitors[i](obj, f);
+}
+
+template <typename T, typename F>
+void VisitFieldAt(T& obj, std::size_t i, F&& f) {
+    constexpr std::size_t N = FieldsCount<T>();
+    if constexpr (N > 0) {
+        VisitFieldAt(obj, i, f, std::make_index_sequence<N>{});
+    }
+}
+
+// the same as above, but with the type of the i-th field
+template <typename T, typename F, std::size_t... Is>
+void VisitFieldTypeAt(std::size_t i, F& f, std::index_sequence<Is...>) {
+    using Visitor = void (*)(F&);
+    static constexpr Visitor kVisitors[] = {
+        [](F& fn) { fn(std::type_identity<FieldType<Is, T>>{}); }...};
+    kVisitors[i](f);
+}
+
+template <typename T, typename F>
+void VisitFieldTypeAt(std::size_t i, F&& f) {
+    constexpr std::size_t N = FieldsCount<T>();
+    if constexpr (N > 0) {
+        VisitFieldTypeAt<T>(i, f, std::make_index_sequence<N>{});
+    }
+}
+
+template <typename T>
+void DiffFields(const T& a, const T& b, std::vector<std::uint32_t>& path,
+                std::vector<FieldChange>& changes);
+
+template <typename T>
+void DiffField(const T& a, const T& b, std::uint32_t idx,
+               std::vector<std::uint32_t>& path,
+               std::vector<FieldChange>& changes) {
+    path.push_back(idx);
+    if constexpr (IsAggregateStruct<T>) {
+        DiffFields(a, b, path, changes);
+    } else if (!EqualValue(a, b)) {
+        auto& change = changes.emplace_back();
+        change.path = path;
+        binary::FormatBinaryValue(change.value, b);
+    }
+    path.pop_back();
+}
+
+template <typename T>
+void DiffFields(const T& a, const T& b, std::vector<std::uint32_t>& path,
+                std::vector<FieldChange>& changes) {
+    // the packed struct is compared as a whole first
+    if constexpr (IsBytewiseEqual<T>) {
+        if (EqualValue(a, b)) return;
+    }
+
+    VisitFields(a, [&](const auto&... xs) {
+        VisitFields(b, [&](const auto&... ys) {
+            std::uint32_t idx = 0;
+            (DiffField(xs, ys, idx++, path, changes), ...);
+        });
+    });
+}
+
+// the field at the path is decoded from the value
+template <typename T>
+bool ApplyChange(binary::_::Decoder& d, T& obj, const FieldChange& change,
+                 std::size_t depth) {
+    const std::uint32_t idx = change.path[depth];
+    if (idx >= FieldsCount<T>()) {
+        return d.E(binary::kErrorParseFailure, "invalid field index {}", idx);
+    }
+
+    bool ok = true;
+    VisitFieldAt(obj, idx, [&](auto& field) {
+        using F = std::remove_cvref_t<decltype(field)>;
+        if (depth + 1 == change.path.size()) {
+            binary::_::Decoder leaf(change.value);
+            binary::_::ParseItem(leaf, field);
+            if (!leaf.IsError() && !leaf.IsEof()) {
+                leaf.E(binary::kErrorParseFailure, "unexpected trailing bytes");
+            }
+            if (leaf.IsError()) {
+                ok = d.E(leaf.error().value(), "{}", leaf.detail_error());
+            }
+        } else if constexpr (IsAggregateStruct<F>) {
+            ok = ApplyChange(d, field, change, depth + 1);
+        } else {
+            ok = d.E(binary::kErrorParseFailure, "invalid path");
+        }
+    });
+    return ok;
+}
+
+using ChangeSpan = std::span<const FieldChange* const>;
+
+template <typename Stream, typename T>
+bool FormatMergePatch(Stream& s, binary::_::Decoder& d, ChangeSpan changes,
+                      std::size_t depth) {
+    constexpr auto& names = kFieldNames<T>;
+
+    // notes, only the empty patch has no changes, since the nested objects
+    // are written for the changes under them
+    if (changes.empty()) {
+        s.EmptyObject();
+        return true;
+    }
+
+    s.BeginObject();
+    for (std::size_t i = 0, j = 0; i < changes.size(); i = j) {
+        const std::uint32_t idx = changes[i]->path[depth];
+        if (idx >= names.size()) {
+            return d.E(binary::kErrorParseFailure, "invalid field index {}",
+                       idx);
+        }
+
+        for (j = i + 1; j < changes.size(); ++j) {
+            if (changes[j]->path[depth] != idx) break;
+        }
+
+        if (i > 0) s.ValueSeparator();
+        json::_::FormatJsonKey(s, names[idx]);
+        s.NameSeparator();
+
+        bool ok = true;
+        VisitFieldTypeAt<T>(idx, [&](auto type) {
+            using F = typename decltype(type)::type;
+            const FieldChange& change = *changes[i];
+            if (depth + 1 == change.path.size()) {
+                F value{};
+                binary::_::Decoder leaf(change.value);
+                binary::_::ParseItem(leaf, value);
+                if (leaf.IsError()) {
+                    ok = d.E(leaf.error().value(), "{}", leaf.detail_error());
+                    return;
+                }
+                json::FormatJsonValue(s, value);
+            } else if constexpr (IsAggregateStruct<F>) {
+                ok = FormatMergePatch<Stream, F>(
+                    s, d, changes.subspan(i, j - i), depth + 1);
+            } else {
+                ok = d.E(binary::kErrorParseFailure, "invalid path");
+            }
+        });
+        if (!ok) return false;
+    }
+    s.EndObject();
+    return true;
+}
+
+}  // namespace _
+
+// returns the changes from a to b
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+Patch<T> Diff(const T& a, const T& b) {
+    Patch<T> patch;
+    std::vector<std::uint32_t> path;
+    _::DiffFields(a, b, path, patch.changes);
+    return patch;
+}
+
+// applies the changes in place, e.g., Apply(a, Diff(a, b)) makes a equal to b
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code Apply(T& obj, const Patch<T>& patch,
+                      std::string* detail_emsg = nullptr) {
+    binary::_::Decoder d({});
+    for (const auto& change : patch.changes) {
+        if (change.path.empty()) {
+            d.E(binary::kErrorParseFailure, "empty path");
+        }
+        if (d.IsError() || !_::ApplyChange(d, obj, change, 0)) break;
+    }
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+template <typename Stream, typename T>
+inline void ToBinaryPatch(Stream& s, const Patch<T>& patch) {
+    binary::_::PutVarint(s, patch.changes.size());
+    for (const auto& change : patch.changes) {
+        binary::_::PutVarint(s, change.path.size());
+        for (auto idx : change.path) {
+            binary::_::PutVarint(s, idx);
+        }
+        binary::_::PutVarint(s, change.value.size());
+        s.append(change.value);
+    }
+}
+
+// notes, the patch is only decoded here, and the paths and values are
+// validated by Apply
+template <typename T>
+std::error_code FromBinaryPatch(std::string_view data, Patch<T>& patch,
+                                std::string* detail_emsg = nullptr) {
+    binary::_::Decoder d(data);
+
+    // notes, each change takes two bytes at least, i.e., the depth and the
+    // size of the value, and each index of the path takes one byte at least,
+    // so that the lengths are bounded by the input before the allocations
+    std::uint64_t n = 0;
+    if (d.ReadLength(&n, 2)) {
+        patch.changes.resize(n);
+    }
+    for (auto& change : patch.changes) {
+        std::uint64_t depth = 0;
+        if (!d.ReadLength(&depth)) break;
+
+        change.path.resize(depth);
+        for (auto& idx : change.path) {
+            std::uint64_t v = 0;
+            if (!d.ReadVarint(&v)) break;
+            idx = static_cast<std::uint32_t>(v);
+        }
+        if (d.IsError()) break;
+
+        std::uint64_t size = 0;
+        const char* p = nullptr;
+        if (!d.ReadLength(&size) || !d.Take(size, &p)) break;
+        change.value.assign(p, size);
+    }
+
+    if (!d.IsError() && !d.IsEof()) {
+        d.E(binary::kErrorParseFailure, "unexpected trailing bytes");
+    }
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+// writes the patch as the json merge patch, which fails only if the patch is
+// malformed, e.g., decoded from the corrupted input. notes, the leaves are
+// replaced rather than merged, see above
+template <typename Stream, typename T>
+std::error_code ToJsonMergePatch(Stream& s, const Patch<T>& patch,
+                                 std::string* detail_emsg = nullptr) {
+    std::vector<const FieldChange*> changes;
+    binary::_::Decoder d({});
+    for (const auto& change : patch.changes) {
+        if (change.path.empty()) {
+            d.E(binary::kErrorParseFailure, "empty path");
+        }
+        changes.push_back(&change);
+    }
+
+    // the changes of the same field should be adjacent
+    std::stable_sort(changes.begin(), changes.end(),
+                     [](const FieldChange* a, const FieldChange* b) {
+                         return a->path < b->path;
+                     });
+
+    if (!d.IsError()) {
+        _::FormatMergePatch<Stream, T>(s, d, changes, 0);
+    }
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+}  // namespace reflpp
@@ -0,0 +1,82 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// the compact native binary, which isn't self-describing. the padding-free
+// runs of the trivially copyable fields are copied as a whole
+
+struct Tick {
+    std::int64_t ts;
+    std::int32_t bid;
+    std::int32_t ask;
+    std::string symbol;
+    std::vector<std::int32_t> sizes;
+};
+
+// the offsets are measured, so that the fields moved by alignas aren't
+// copied with the padding before them
+struct Aligned {
+    char a;
+    alignas(4) char b;
+    std::int32_t c;
+};
+
+// notes, the offsets can't be measured with the string, so that the fields
+// are encoded one by one
+struct Labeled {
+    std::int32_t a;
+    alignas(8) std::int32_t b;
+    std::int32_t c;
+    std::string label;
+};
+
+int main() {
+    Tick tick{1700000000, 100, 101, "AAPL", {10, 20, 30}};
+
+    std::string buf;
+    ::reflpp::binary::ToBinary(buf, tick);
+    std::cout << "Binary: " << buf.size() << " bytes" << std::endl;
+
+    Tick tick1{};
+    auto ec = ::reflpp::binary::FromBinary(buf, tick1);
+    REFLPP_ASSERT(!ec);
+    REFLPP_ASSERT(tick1.ts == tick.ts && tick1.ask == tick.ask);
+    REFLPP_ASSERT(tick1.symbol == tick.symbol && tick1.sizes == tick.sizes);
+
+    // the empty vector has no storage to copy into
+    Tick empty{1, 2, 3, "", {}};
+    buf.clear();
+    ::reflpp::binary::ToBinary(buf, empty);
+    ec = ::reflpp::binary::FromBinary(buf, tick1);
+    REFLPP_ASSERT(!ec && tick1.ts == 1 && tick1.sizes.empty());
+
+    Aligned aligned{'x', 'y', 7};
+    std::string buf1;
+    ::reflpp::binary::ToBinary(buf1, aligned);
+    REFLPP_ASSERT(buf1.size() == 6);
+
+    Aligned aligned1{};
+    ec = ::reflpp::binary::FromBinary(buf1, aligned1);
+    REFLPP_ASSERT(!ec && aligned1.a == 'x' && aligned1.b == 'y');
+    REFLPP_ASSERT(aligned1.c == 7);
+    std::cout << "Aligned: " << buf1.size() << " bytes, the offset of b is "
+              << ::reflpp::GetFieldOffsets<Aligned>()[1] << std::endl;
+
+    Labeled labeled{1, 2, 3, "x"}, labeled1{};
+    buf1.clear();
+    ::reflpp::binary::ToBinary(buf1, labeled);
+    ec = ::reflpp::binary::FromBinary(buf1, labeled1);
+    REFLPP_ASSERT(!ec && labeled1.b == 2 && labeled1.c == 3);
+
+    // the trailing bytes are rejected
+    std::string detail;
+    ec = ::reflpp::binary::FromBinary(buf + "x", tick1, &detail);
+    REFLPP_ASSERT(ec);
+    std::cout << "Trailing: " << detail << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the flat buffer is read in place without deserializing, which is similar to
+// flatbuffers. notes, the buffer should be verified unless it's trusted
+
+struct Header {
+    std::uint32_t version;
+    std::array<std::int32_t, 3> dims;
+};
+
+struct Frame {
+    char tag;
+    Header header;
+    std::string name;
+    std::vector<float> samples;
+    std::map<std::string, int> labels;
+    std::optional<std::string> comment;
+};
+
+int main() {
+    Frame frame{'f', {2, {4, 5, 6}}, "frame0", {0.5f, 1.5f, 2.5f},
+                {{"a", 1}, {"b", 2}}, std::nullopt};
+
+    std::string buf;
+    ::reflpp::flat::ToFlat(buf, frame);
+    REFLPP_ASSERT(!::reflpp::flat::Verify<Frame>(buf));
+
+    auto view = ::reflpp::flat::GetView<Frame>(buf);
+    auto header = view.Get<1>();
+    std::cout << "Name: " << view.Get<2>() << ", version "
+              << header.Get<0>() << std::endl;
+
+    // the elements of containers are 8-byte aligned in the buffer, e.g.,
+    // std::string, so that the memcpyable ones are viewed as a span
+    float sum = 0;
+    for (float v : view.Get<3>().span()) {
+        sum += v;
+    }
+    REFLPP_ASSERT(sum == 4.5f);
+
+    // the fixed arrays are packed inline without alignment, e.g., the dims
+    // follow the one-byte tag, which are only read by iterating, and span()
+    // is rejected at compile time
+    std::int32_t volume = 1;
+    for (std::int32_t d : header.Get<1>()) {
+        volume *= d;
+    }
+    REFLPP_ASSERT(volume == 120);
+
+    // the iterators are random access, e.g., the sorted samples are searched
+    // by the standard algorithms
+    auto samples = view.Get<3>();
+    REFLPP_ASSERT(std::distance(samples.begin(), samples.end()) == 3);
+    REFLPP_ASSERT(std::binary_search(samples.begin(), samples.end(), 1.5f));
+    REFLPP_ASSERT(samples.end()[-1] == 2.5f);
+
+    // the map is viewed as the sequence of key-value pairs
+    for (auto [key, value] : view.Get<4>()) {
+        std::cout << "Label: " << key << "=" << value << std::endl;
+    }
+    REFLPP_ASSERT(!view.Get<5>().has_value());
+
+    Frame frame1;
+    auto ec = ::reflpp::flat::FromFlat(buf, frame1);
+    REFLPP_ASSERT(!ec && frame1.labels == frame.labels);
+
+    // the truncated buffer is rejected by the verification
+    ec = ::reflpp::flat::Verify<Frame>(std::string_view(buf).substr(0, 40));
+    REFLPP_ASSERT(ec);
+    std::cout << "Truncated: " << ec.message() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the protobuf wire format, which interoperates with the messages generated
+// by protoc, e.g.,
+//
+//   message Point { int32 x = 1; int32 y = 2; }
+//   message Path {
+//       string name = 1;
+//       repeated Point points = 2;
+//       repeated int64 ids = 3;
+//       map<string, int32> attrs = 4;
+//       sint32 delta = 7;
+//   }
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+struct Path {
+    std::string name;
+    std::vector<Point> points;
+    std::vector<std::int64_t> ids;
+    std::map<std::string, std::int32_t> attrs;
+    std::int32_t delta;
+};
+
+template <>
+struct reflpp::protobuf::ProtobufFields<Path> {
+    static constexpr std::array<FieldOptions, 5> value{{
+        {1},
+        {2},
+        {3},
+        {4},
+        {7, kZigzag},
+    }};
+};
+
+// the older version of Path, which has only the name
+struct PathV1 {
+    std::string name;
+};
+
+int main() {
+    Path path{"route", {{1, 2}, {3, 4}}, {100, 200}, {{"speed", 60}}, -5};
+
+    std::string buf;
+    ::reflpp::protobuf::ToProtobuf(buf, path);
+    std::cout << "Protobuf: " << buf.size() << " bytes" << std::endl;
+
+    Path path1{};
+    auto ec = ::reflpp::protobuf::FromProtobuf(buf, path1);
+    REFLPP_ASSERT(!ec && path1.points.size() == 2 && path1.points[1].y == 4);
+    REFLPP_ASSERT(path1.ids == path.ids && path1.attrs == path.attrs);
+    REFLPP_ASSERT(path1.delta == -5);
+
+    // the unknown fields are skipped
+    PathV1 old;
+    ec = ::reflpp::protobuf::FromProtobuf(buf, old);
+    REFLPP_ASSERT(!ec && old.name == "route");
+
+    // the bytes from protoc, i.e., Point{x: 150, y: 0}, where the default
+    // value is omitted, so that the missing field keeps its value
+    Point point{0, 9};
+    ec = ::reflpp::protobuf::FromProtobuf("\x08\x96\x01", point);
+    REFLPP_ASSERT(!ec && point.x == 150 && point.y == 9);
+    std::cout << "Point: " << point.x << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the versioned binary matches the fields by the fingerprints of their names
+// and types, so that the fields can be added, removed and reordered
+
+struct Profile {
+    std::string name;
+    std::vector<std::int64_t> visits;
+};
+
+// the fields are reordered, one is removed, and one is added
+struct ProfileV2 {
+    std::vector<std::int64_t> visits;
+    std::optional<std::string> email;
+};
+
+// the same fields in another struct
+struct Visitor {
+    std::string name;
+    std::vector<std::int64_t> visits;
+};
+
+// the visits of History are delta encoded, which changes the binary of the
+// structs containing it, even though the types are the same
+struct History {
+    std::vector<std::int64_t> visits;
+};
+
+template <>
+struct reflpp::binary::BinaryFields<History> {
+    static constexpr std::array<Encoding, 1> value{kDelta};
+};
+
+struct PlainHistory {
+    std::vector<std::int64_t> visits;
+};
+
+struct User {
+    int id;
+    History history;
+};
+
+struct PlainUser {
+    int id;
+    PlainHistory history;
+};
+
+int main() {
+    // the fingerprints are computed at compile time, and the struct name is
+    // excluded, so that the same fields have the same fingerprint
+    static_assert(::reflpp::kFingerprint<Profile> ==
+                  ::reflpp::kFingerprint<Visitor>);
+    static_assert(::reflpp::kFingerprint<History> ==
+                  ::reflpp::kFingerprint<PlainHistory>);
+    static_assert(::reflpp::kFingerprint<Profile> !=
+                  ::reflpp::kFingerprint<ProfileV2>);
+    static_assert(::reflpp::kFieldFingerprints<Profile>[1] ==
+                  ::reflpp::kFieldFingerprints<ProfileV2>[0]);
+
+    Profile profile{"alice", {100, 200, 300}};
+
+    std::string buf;
+    ::reflpp::binary::ToVersionedBinary(buf, profile);
+
+    // the same type takes the fast path, which decodes the body directly
+    Profile profile1;
+    auto ec = ::reflpp::binary::FromVersionedBinary(buf, profile1);
+    REFLPP_ASSERT(!ec && profile1.visits == profile.visits);
+
+    ProfileV2 profile2;
+    profile2.email = "alice@example.com";
+    ec = ::reflpp::binary::FromVersionedBinary(buf, profile2);
+    REFLPP_ASSERT(!ec && profile2.visits == profile.visits);
+    REFLPP_ASSERT(profile2.email == "alice@example.com");
+    std::cout << "Versioned: " << buf.size() << " bytes, "
+              << profile2.visits.size() << " visits" << std::endl;
+
+    // the encodings of the nested struct are a part of the fingerprints, so
+    // that the mismatched field is skipped rather than decoded as garbage
+    User user{1, {{1000, 1001, 1003}}};
+    std::string buf1;
+    ::reflpp::binary::ToVersionedBinary(buf1, user);
+
+    PlainUser plain{};
+    ec = ::reflpp::binary::FromVersionedBinary(buf1, plain);
+    REFLPP_ASSERT(!ec && plain.id == 1 && plain.history.visits.empty());
+
+    User user1{};
+    ec = ::reflpp::binary::FromVersionedBinary(buf1, user1);
+    REFLPP_ASSERT(!ec && user1.history.visits == user.history.visits);
+    std::cout << "Nested encodings: " << plain.history.visits.size() << " vs "
+              << user1.history.visits.size() << " visits" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// the compact encodings of the integer and bool containers, which are opted
+// in by fields. notes, the bit-packed values are unpacked by avx2 if it's
+// enabled, e.g., -mavx2, and the results are the same
+
+struct Series {
+    std::string name;
+    std::vector<std::int64_t> ts;
+    std::vector<std::uint32_t> levels;
+    std::vector<bool> flags;
+    std::vector<std::uint64_t> ids;
+};
+
+template <>
+struct reflpp::binary::BinaryFields<Series> {
+    static constexpr std::array<Encoding, 5> value{
+        kPlain, kDelta, kBitPacked, kBitset, kBitPacked,
+    };
+};
+
+// the same fields without the encodings
+struct PlainSeries {
+    std::string name;
+    std::vector<std::int64_t> ts;
+    std::vector<std::uint32_t> levels;
+    std::vector<bool> flags;
+    std::vector<std::uint64_t> ids;
+};
+
+int main() {
+    Series series{"cpu", {}, {}, {}, {}};
+    for (std::int64_t i = 0; i < 1000; ++i) {
+        series.ts.push_back(1700000000000 + i * 1000 + i % 7);
+        series.levels.push_back(1000 + i % 100);
+        series.flags.push_back(i % 3 == 0);
+        // the full 64-bit width, which is read byte by byte
+        series.ids.push_back(~std::uint64_t{0} - i * 0x100000001ull);
+    }
+
+    std::string buf;
+    ::reflpp::binary::ToBinary(buf, series);
+
+    PlainSeries plain{series.name, series.ts, series.levels, series.flags,
+                      series.ids};
+    std::string plain_buf;
+    ::reflpp::binary::ToBinary(plain_buf, plain);
+    std::cout << "Encoded: " << buf.size() << " bytes, plain: "
+              << plain_buf.size() << " bytes" << std::endl;
+
+    Series series1;
+    auto ec = ::reflpp::binary::FromBinary(buf, series1);
+    REFLPP_ASSERT(!ec);
+    REFLPP_ASSERT(series1.ts == series.ts && series1.levels == series.levels);
+    REFLPP_ASSERT(series1.flags == series.flags && series1.ids == series.ids);
+
+    // the constant values take one bit each, and the empty containers only
+    // take the length
+    Series constant{"idle", {5}, std::vector<std::uint32_t>(100, 7), {}, {}};
+    buf.clear();
+    ::reflpp::binary::ToBinary(buf, constant);
+    ec = ::reflpp::binary::FromBinary(buf, series1);
+    REFLPP_ASSERT(!ec && series1.levels == constant.levels);
+    REFLPP_ASSERT(series1.flags.empty() && series1.ids.empty());
+    std::cout << "Constant: " << buf.size() << " bytes" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the rows are exported as the arrow ipc formats, which are read by pyarrow,
+// pandas and polars, e.g.,
+//   pyarrow.feather.read_table("trades.arrow")
+
+enum class Side : std::uint8_t {
+    kBuy = 1,
+    kSell = 2,
+};
+
+struct Trade {
+    std::int64_t ts;
+    std::string symbol;
+    double price;
+    std::optional<std::int32_t> qty;
+    Side side;
+    bool settled;
+};
+
+int main() {
+    std::vector<Trade> trades;
+    for (int i = 0; i < 1000; ++i) {
+        std::optional<std::int32_t> qty;
+        if (i % 10) qty = i;
+        trades.push_back({1700000000000 + i, i % 2 ? "AAPL" : "MSFT",
+                          100 + i * 0.5, qty, i % 3 ? Side::kBuy : Side::kSell,
+                          i % 2 == 0});
+    }
+
+    // the file format, i.e., feather v2, starts and ends with the magic
+    std::string file;
+    ::reflpp::arrow::ToArrowFile(file, trades);
+    REFLPP_ASSERT(file.starts_with(std::string_view("ARROW1", 6)));
+    REFLPP_ASSERT(file.ends_with(std::string_view("ARROW1", 6)));
+    std::ofstream("trades.arrow", std::ios::binary) << file;
+    std::cout << "File: " << file.size() << " bytes" << std::endl;
+
+    // the streaming format ends with the end-of-stream marker
+    std::string stream;
+    ::reflpp::arrow::ToArrowStream(stream, trades);
+    constexpr std::string_view kEndOfStream{"\xff\xff\xff\xff\0\0\0\0", 8};
+    REFLPP_ASSERT(stream.ends_with(kEndOfStream));
+    std::cout << "Stream: " << stream.size() << " bytes" << std::endl;
+
+    // the empty rows have the schema only
+    std::string empty;
+    ::reflpp::arrow::ToArrowStream(empty, std::vector<Trade>{});
+    REFLPP_ASSERT(!empty.empty());
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// SoaVector stores the rows as columns, i.e., each field is in its own
+// contiguous array, and the rows are accessed through the proxy references
+
+struct Particle {
+    std::int32_t id;
+    float x;
+    float y;
+    std::string label;
+};
+
+int main() {
+    ::reflpp::SoaVector<Particle> particles;
+    for (std::int32_t i = 0; i < 8; ++i) {
+        particles.push_back({(i * 5) % 8, i * 1.0f, i * 2.0f,
+                             "p" + std::to_string((i * 5) % 8)});
+    }
+
+    // the scan over one field only touches its column
+    float sum = 0;
+    for (float x : particles.Column<1>()) {
+        sum += x;
+    }
+    REFLPP_ASSERT(sum == 28.0f);
+
+    // the row is gathered from the columns, and scattered back on assignment
+    Particle p = particles[3];
+    p.label = "moved";
+    particles[3] = p;
+    REFLPP_ASSERT(particles.Get<3>(3) == "moved");
+
+    // the rows are swapped column by column through the proxies, so that
+    // the standard algorithms work
+    std::sort(particles.begin(), particles.end(),
+              [](const Particle& a, const Particle& b) { return a.id < b.id; });
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        REFLPP_ASSERT(particles.Get<0>(i) == static_cast<std::int32_t>(i));
+    }
+    std::cout << "Sorted labels:";
+    for (auto row : particles) {
+        std::cout << " " << row.Get<3>();
+    }
+    std::cout << std::endl;
+
+    particles.pop_back();
+    REFLPP_ASSERT(particles.size() == 7);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <reflpp.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// the aggregate kernels over the numeric columns, which are vectorized by
+// avx2 or sse2 if enabled, and split into chunks for multiple threads
+
+struct Reading {
+    std::int32_t sensor;
+    double value;
+    std::int64_t ts;
+};
+
+int main() {
+    std::vector<double> column;
+    ::reflpp::SoaVector<Reading> soa;
+    std::vector<Reading> rows;
+    for (int i = 0; i < 100000; ++i) {
+        Reading r{i % 16, std::sin(i * 0.001) * 100, 1700000000 + i};
+        column.push_back(r.value);
+        soa.push_back(r);
+        rows.push_back(r);
+    }
+
+    ::reflpp::AggregateOptions opts;
+    opts.threads = 4;
+    opts.min_chunk_size = 4096;
+
+    auto stats = ::reflpp::Aggregate(column, opts);
+    std::cout << fmt::format("count {}, mean {:.3f}, min {:.3f}, max {:.3f}",
+                             stats.count, stats.mean(), stats.min, stats.max)
+              << std::endl;
+
+    // the same stats from the column of SoaVector and the field of the rows
+    auto soa_stats = ::reflpp::Aggregate<1>(soa, opts);
+    auto row_stats = ::reflpp::Aggregate<1>(rows, opts);
+    REFLPP_ASSERT(soa_stats.count == stats.count && row_stats.max == stats.max);
+
+    // the integers are summed as 64-bit integers
+    auto ts = ::reflpp::Aggregate<2>(soa);
+    REFLPP_ASSERT(ts.min == 1700000000 && ts.max == 1700099999);
+
+    // NaNs are ignored by min and max
+    std::vector<float> with_nan{1.0f, std::numeric_limits<float>::quiet_NaN(),
+                                -2.0f};
+    auto nan_stats = ::reflpp::Aggregate(with_nan);
+    REFLPP_ASSERT(nan_stats.min == -2.0f && nan_stats.max == 1.0f);
+
+    // the values out of [lo, hi) are skipped
+    auto counts = ::reflpp::Histogram<0>(soa, 0, 8, 4, opts);
+    REFLPP_ASSERT(counts.size() == 4 && counts[0] == 100000 / 8);
+    std::cout << fmt::format("histogram {}", counts) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the csv of the flat structs, see rfc 4180. the columns are matched to the
+// fields by the header, and the large input is parsed by multiple threads
+
+struct Employee {
+    std::int32_t id;
+    std::string name;
+    std::optional<double> salary;
+    bool active;
+};
+
+// the subset of columns in the other order
+struct Contact {
+    std::string name;
+    std::int32_t id;
+};
+
+int main() {
+    std::vector<Employee> staff{
+        {1, "Alice", 5000.5, true},
+        {2, "Bob, Jr.", std::nullopt, false},
+        {3, "Carol \"CJ\"\nSmith", 6000, true},
+    };
+
+    std::string csv;
+    ::reflpp::csv::ToCsv(csv, staff);
+    std::cout << "Csv: " << std::endl << csv;
+
+    // the delimiters, quotes and newlines are quoted, and the empty optional
+    // is the empty field
+    std::vector<Employee> staff1;
+    auto ec = ::reflpp::csv::FromCsv(csv, staff1);
+    REFLPP_ASSERT(!ec && staff1.size() == 3);
+    REFLPP_ASSERT(staff1[1].name == "Bob, Jr." && !staff1[1].salary);
+    REFLPP_ASSERT(staff1[2].name == staff[2].name);
+
+    std::vector<Contact> contacts;
+    ec = ::reflpp::csv::FromCsv(csv, contacts);
+    REFLPP_ASSERT(!ec && contacts[2].id == 3 && contacts[0].name == "Alice");
+
+    // the large input is split at the row boundaries, which are found by
+    // counting the quotes, so that the quoted newlines don't split the rows
+    std::vector<Employee> many;
+    for (int i = 0; i < 20000; ++i) {
+        many.push_back(staff[i % 3]);
+        many.back().id = i;
+    }
+    csv.clear();
+    ::reflpp::csv::ToCsv(csv, many);
+
+    ::reflpp::csv::CsvOptions opts;
+    opts.threads = 4;
+    opts.min_chunk_size = 4096;
+    std::vector<Employee> many1;
+    ec = ::reflpp::csv::FromCsv(csv, many1, nullptr, opts);
+    REFLPP_ASSERT(!ec && many1.size() == many.size());
+    REFLPP_ASSERT(many1.back().id == 19999 && many1[5].name == staff[2].name);
+    std::cout << "Parallel: " << many1.size() << " rows" << std::endl;
+
+    // the malformed field is reported
+    std::string detail;
+    ec = ::reflpp::csv::FromCsv("id,name,salary,active\nx,a,1,true\n", staff1,
+                                &detail);
+    REFLPP_ASSERT(ec);
+    std::cout << "Malformed: " << detail << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+// the structs with up to 256 fields are reflected, and the fields are bound
+// only once for all of the fields
+
+struct Wide {
+    int f0, f1, f2, f3, f4, f5, f6, f7, f8, f9;
+    int f10, f11, f12, f13, f14, f15, f16, f17, f18, f19;
+    int f20, f21, f22, f23, f24, f25, f26, f27, f28, f29;
+    int f30, f31, f32, f33, f34, f35, f36, f37, f38, f39;
+    std::string tail;
+};
+
+int main() {
+    static_assert(::reflpp::FieldsCount<Wide>() == 41);
+    static_assert(::reflpp::kFieldNames<Wide>[40] == "tail");
+    static_assert(std::is_same_v<::reflpp::FieldType<40, Wide>, std::string>);
+
+    Wide wide{};
+    ::reflpp::GetField<39>(wide) = 39;
+    ::reflpp::GetField<40>(wide) = "end";
+    REFLPP_ASSERT(wide.f39 == 39 && wide.tail == "end");
+
+    int sum = 0;
+    ::reflpp::ForEach(wide, [&sum](std::size_t idx, const auto& field) {
+        if constexpr (std::is_same_v<decltype(field), const int&>) {
+            sum += field + static_cast<int>(idx);
+        } else {
+            std::cout << "The last field: " << field << std::endl;
+        }
+    });
+    REFLPP_ASSERT(sum == 39 + 39 * 40 / 2);
+
+    return 0;
+}
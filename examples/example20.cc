@@ -0,0 +1,42 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+// the index of field is passed to ForEach as std::integral_constant, which is
+// usable in if constexpr and as the template argument
+
+struct Order {
+    std::uint64_t id;
+    std::string symbol;
+    double price;
+    std::int32_t qty;
+};
+
+int main() {
+    Order order{7, "AAPL", 189.5, 100};
+
+    ::reflpp::ForEach(order, [](auto idx, const auto& field) {
+        constexpr auto name = ::reflpp::kFieldNames<Order>[idx];
+        using F = ::reflpp::FieldType<idx, Order>;
+        if constexpr (std::is_arithmetic_v<F>) {
+            std::cout << name << " = " << field << " (number)" << std::endl;
+        } else {
+            std::cout << name << " = \"" << field << "\"" << std::endl;
+        }
+    });
+
+    // the index is still convertible to std::size_t
+    std::size_t count = 0;
+    ::reflpp::ForEach(order, [&count](std::size_t idx, const auto&) {
+        REFLPP_ASSERT(idx == count);
+        ++count;
+    });
+    REFLPP_ASSERT(count == ::reflpp::FieldsCount<Order>());
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <reflpp.h>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+// the offsets of fields are computed at compile time, and the fields are
+// accessed by the index or the name at runtime
+
+struct Config {
+    char mode;
+    std::int32_t port;
+    std::string host;
+};
+
+// the offsets of the scalar structs are measured, which follows alignas
+struct Packet {
+    std::uint8_t kind;
+    alignas(8) std::int32_t seq;
+    std::array<double, 2> stamp;
+};
+
+// notes, kFieldOffsets fails to compile for the struct, since alignas moves
+// the field without the scalars to measure, but the fields are accessed all
+// the same
+struct Session {
+    char mode;
+    alignas(16) std::int32_t id;
+    std::string user;
+};
+
+int main() {
+    constexpr auto& offsets = ::reflpp::kFieldOffsets<Config>;
+    static_assert(offsets[1] == 4 && offsets[2] == 8);
+    std::cout << fmt::format("The offsets of Config: {}", offsets)
+              << std::endl;
+
+    Config config{'r', 8080, "localhost"};
+
+    // the field is accessed with its exact type, otherwise it's null
+    auto port = ::reflpp::GetField(config, "port");
+    REFLPP_ASSERT(port && port.Is<std::int32_t>());
+    *port.As<std::int32_t>() = 9090;
+    REFLPP_ASSERT(config.port == 9090);
+    REFLPP_ASSERT(port.As<std::int64_t>() == nullptr);
+
+    auto host = ::reflpp::GetField(std::as_const(config), 2);
+    REFLPP_ASSERT(*host.As<std::string>() == "localhost");
+
+    REFLPP_ASSERT(!::reflpp::GetField(config, "missing"));
+    REFLPP_ASSERT(!::reflpp::GetField(config, 3));
+
+    static_assert(::reflpp::kFieldOffsets<Packet>[1] == 8);
+    static_assert(::reflpp::kFieldOffsets<Packet>[2] == 16);
+
+    Session session{'w', 42, "admin"};
+    REFLPP_ASSERT(*::reflpp::GetField(session, "id").As<std::int32_t>() == 42);
+    REFLPP_ASSERT(*::reflpp::GetField(session, 2).As<std::string>() == "admin");
+    static_assert(::reflpp::FindFieldIndex<Config>("host") == 2);
+
+    return 0;
+}
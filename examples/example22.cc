@@ -0,0 +1,42 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+
+// the structural hash, which works on the structs without std::hash, e.g., as
+// the keys of the unordered containers
+
+struct Key {
+    std::uint32_t tenant;
+    std::uint32_t id;
+
+    bool operator==(const Key&) const = default;
+};
+
+struct Sample {
+    std::string name;
+    double value;
+    std::unordered_set<int> tags;
+};
+
+int main() {
+    // the Key without padding is hashed as raw bytes in one pass
+    std::unordered_set<Key, ::reflpp::Hash<Key>> keys{{1, 7}, {2, 7}, {1, 7}};
+    REFLPP_ASSERT(keys.size() == 2);
+    REFLPP_ASSERT(keys.count({2, 7}) == 1);
+
+    // notes, the unordered containers are hashed regardless of the order, and
+    // -0.0 is hashed as 0.0, so that the equal values have the same hash
+    Sample a{"cpu", 0.0, {1, 2, 3}};
+    Sample b{"cpu", -0.0, {3, 2, 1}};
+    REFLPP_ASSERT(::reflpp::HashOf(a) == ::reflpp::HashOf(b));
+    std::cout << "The hash of sample: " << ::reflpp::HashOf(a) << std::endl;
+
+    // the seed gives another hash function
+    REFLPP_ASSERT(::reflpp::HashOf(a, 1) != ::reflpp::HashOf(a));
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// the structural equality and ordering, which work on the structs without any
+// user-defined operators
+
+struct Key {
+    std::uint32_t tenant;
+    std::uint32_t id;
+};
+
+struct Sample {
+    std::string name;
+    double value;
+    std::unordered_set<int> tags;
+};
+
+int main() {
+    // the Key without padding is compared as raw bytes
+    std::unordered_map<Key, std::string, ::reflpp::Hash<Key>,
+                       ::reflpp::Equal<Key>>
+        names;
+    names[{1, 7}] = "seven";
+    names[{2, 7}] = "other";
+    REFLPP_ASSERT(names.size() == 2);
+    REFLPP_ASSERT(names.at({1, 7}) == "seven");
+
+    std::vector<Key> keys{{2, 1}, {1, 9}, {1, 3}};
+    std::sort(keys.begin(), keys.end(), ::reflpp::Less<Key>{});
+    REFLPP_ASSERT(keys.front().tenant == 1 && keys.front().id == 3);
+    static_assert(std::is_same_v<decltype(::reflpp::Compare(keys[0], keys[1])),
+                                 std::strong_ordering>);
+    REFLPP_ASSERT(::reflpp::Compare(keys[0], keys[1]) < 0);
+
+    // notes, the unordered containers are equal regardless of the order, and
+    // -0.0 is equal to 0.0
+    Sample a{"cpu", 0.0, {1, 2, 3}};
+    Sample b{"cpu", -0.0, {3, 2, 1}};
+    REFLPP_ASSERT(::reflpp::Equal<Sample>{}(a, b));
+
+    // the floats are ordered partially, e.g., NaN is unordered
+    static_assert(std::is_same_v<decltype(::reflpp::Compare(a.value, b.value)),
+                                 std::partial_ordering>);
+    REFLPP_ASSERT(::reflpp::Compare(1.0, std::nan("")) ==
+                  std::partial_ordering::unordered);
+    std::cout << "The keys are sorted by tenant and id" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// the patch is the changed leaf fields between two objects, which is applied
+// in place, sent as the binary patch, or written as the json merge patch
+
+struct Limits {
+    std::uint32_t cpu;
+    std::uint32_t memory;
+};
+
+struct Service {
+    std::string name;
+    Limits limits;
+    std::vector<int> ports;
+    std::map<std::string, std::string> labels;
+};
+
+int main() {
+    Service old_svc{"web", {2, 512}, {80}, {{"env", "dev"}, {"team", "a"}}};
+    Service new_svc = old_svc;
+    new_svc.limits.memory = 1024;
+    new_svc.ports.push_back(443);
+    new_svc.labels.erase("team");
+
+    // the nested struct is compared field by field, and the rest are leaves
+    auto patch = ::reflpp::Diff(old_svc, new_svc);
+    REFLPP_ASSERT(patch.size() == 3);
+    REFLPP_ASSERT((patch.changes[0].path == std::vector<std::uint32_t>{1, 1}));
+
+    std::string binary;
+    ::reflpp::ToBinaryPatch(binary, patch);
+    std::cout << "The binary patch: " << binary.size() << " bytes"
+              << std::endl;
+
+    ::reflpp::Patch<Service> patch1;
+    auto ec = ::reflpp::FromBinaryPatch(binary, patch1);
+    REFLPP_ASSERT(!ec);
+
+    Service svc = old_svc;
+    ec = ::reflpp::Apply(svc, patch1);
+    REFLPP_ASSERT(!ec);
+    REFLPP_ASSERT(::reflpp::Equal<Service>{}(svc, new_svc));
+
+    // the merge patch only has the changed fields. notes, the changed map is
+    // replaced as a whole, i.e., the removed key "team" isn't null in the
+    // merge patch, but it's gone after FromJson
+    ::reflpp::json::CompactJsonFormatter merge;
+    ec = ::reflpp::ToJsonMergePatch(merge, patch);
+    REFLPP_ASSERT(!ec);
+    std::cout << "The json merge patch: " << merge << std::endl;
+
+    svc = old_svc;
+    ec = ::reflpp::json::FromJson(merge, svc);
+    REFLPP_ASSERT(!ec);
+    REFLPP_ASSERT(svc.name == "web" && svc.limits.cpu == 2);
+    REFLPP_ASSERT(svc.labels.size() == 1 && !svc.labels.count("team"));
+    REFLPP_ASSERT(::reflpp::Equal<Service>{}(svc, new_svc));
+
+    // the empty patch is the empty object
+    ::reflpp::json::PrettyJsonFormatter pretty;
+    ec = ::reflpp::ToJsonMergePatch(pretty, ::reflpp::Diff(svc, new_svc));
+    REFLPP_ASSERT(!ec && std::string_view(pretty) == "{}");
+
+    // the invalid path is reported by Apply
+    patch1.changes[0].path = {9};
+    std::string emsg;
+    ec = ::reflpp::Apply(svc, patch1, &emsg);
+    REFLPP_ASSERT(ec);
+    std::cout << "The invalid patch: " << emsg << std::endl;
+
+    // the counts of the corrupted patch are bounded by the input
+    ::reflpp::Patch<Service> patch2;
+    ec = ::reflpp::FromBinaryPatch("\xff\xff\xff\xff\x0f", patch2, &emsg);
+    REFLPP_ASSERT(ec && patch2.changes.empty());
+    ec = ::reflpp::FromBinaryPatch("\x01\xff\x0f", patch2, &emsg);
+    REFLPP_ASSERT(ec);
+    std::cout << "The corrupted patch: " << emsg << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+// the flattened paths of the leaf fields, which recurse into the nested
+// structs, e.g., "server.port", and are looked up at compile time or runtime
+
+struct Endpoint {
+    std::string host;
+    std::uint16_t port;
+};
+
+struct Settings {
+    Endpoint server;
+    Endpoint backup;
+    bool verbose;
+};
+
+int main() {
+    constexpr auto& paths = ::reflpp::kFieldPaths<Settings>;
+    static_assert(paths.size() == 5);
+    static_assert(paths[1] == "server.port");
+    std::cout << fmt::format("The paths: {}", paths) << std::endl;
+
+    Settings settings{{"primary", 80}, {"secondary", 8080}, false};
+
+    // the path index is the compile-time constant
+    ::reflpp::GetFieldByPath<3>(settings) = 8081;
+    REFLPP_ASSERT(settings.backup.port == 8081);
+
+    ::reflpp::ForEachFieldPath(settings, [&paths](auto idx, const auto& f) {
+        std::cout << "  " << paths[idx] << " = " << f << std::endl;
+    });
+
+    // the lookup by name at runtime, which is null if not found
+    constexpr auto idx = ::reflpp::FindFieldPath<Settings>("backup.host");
+    static_assert(idx && *idx == 2);
+    REFLPP_ASSERT(!::reflpp::FindFieldPath<Settings>("backup"));
+
+    auto host = ::reflpp::GetFieldByPath(settings, "server.host");
+    REFLPP_ASSERT(host && *host.As<std::string>() == "primary");
+    *host.As<std::string>() = "localhost";
+    REFLPP_ASSERT(settings.server.host == "localhost");
+
+    auto verbose = ::reflpp::GetFieldByPath(std::as_const(settings), 4);
+    REFLPP_ASSERT(verbose.Is<bool>() && !*verbose.As<bool>());
+    REFLPP_ASSERT(!::reflpp::GetFieldByPath(settings, "server.missing"));
+
+    return 0;
+}
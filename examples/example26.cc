@@ -0,0 +1,44 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// the layout of structs, i.e., the offsets and the padding bytes, and the
+// field order with the least padding, which are computed at compile time.
+// see also `make layout-report`
+
+struct Order {
+    char side;
+    std::int64_t id;
+    double price;
+    std::int32_t qty;
+};
+
+// the offsets are measured, and the alignment of the field moved by alignas
+// is estimated from its offset
+struct Packet {
+    std::uint8_t kind;
+    alignas(8) std::int32_t seq;
+    std::uint8_t flags;
+};
+
+int main() {
+    constexpr auto& layout = ::reflpp::kStructLayout<Order>;
+    static_assert(layout.size == 32 && layout.padding == 11);
+    static_assert(layout.fields[1].offset == 8);
+    static_assert(layout.fields[1].padding == 7);
+    static_assert(layout.best_size == 24 && layout.saving() == 8);
+
+    constexpr auto& packet = ::reflpp::kStructLayout<Packet>;
+    static_assert(packet.fields[1].offset == 8 && packet.fields[1].align == 8);
+    static_assert(packet.best_order[0] == 1 && packet.best_size == 8);
+
+    std::string report;
+    ::reflpp::FormatLayoutReport<Order>(report);
+    ::reflpp::FormatLayoutReport<Packet>(report);
+    std::cout << report;
+
+    return 0;
+}
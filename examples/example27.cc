@@ -0,0 +1,50 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <forward_list>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// the memory footprint of objects, i.e., the inline bytes, and the heap bytes
+// and allocations owned by them recursively
+
+struct Order {
+    std::int64_t id;
+    double price;
+};
+
+struct Cache {
+    std::string name;
+    std::vector<std::int64_t> keys;
+    std::map<int, std::string> values;
+    std::unique_ptr<Order> last;
+    std::forward_list<int> free_list;
+};
+
+int main() {
+    Cache cache;
+    // notes, the long name isn't stored in the small string buffer
+    cache.name = std::string(64, 'x');
+    cache.keys.reserve(16);
+    cache.values = {{1, "a"}, {2, "b"}};
+    cache.last = std::make_unique<Order>();
+    cache.free_list = {1, 2, 3};
+
+    auto usage = ::reflpp::DeepSize(cache);
+    std::cout << "The cache takes " << usage.total() << " bytes in "
+              << usage.allocations << " allocations" << std::endl;
+    REFLPP_ASSERT(usage.inline_bytes == sizeof(Cache));
+    // the name, keys, two map nodes, three list nodes and the last order
+    REFLPP_ASSERT(usage.allocations == 8);
+
+    for (const auto& [name, field] : ::reflpp::DeepSizeByField(cache)) {
+        std::cout << "  " << name << ": " << field.total() << " bytes"
+                  << std::endl;
+    }
+
+    return 0;
+}
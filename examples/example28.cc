@@ -0,0 +1,59 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// the random values of structs, e.g., the corpora of benchmarks and fuzzing,
+// which are deterministic for the seed of engine
+
+struct User {
+    std::uint64_t id;
+    std::string name;
+    std::optional<int> age;
+    std::vector<double> scores;
+    std::map<std::string, bool> flags;
+};
+
+// the recursive type is bounded by the max depth
+struct Node {
+    int value;
+    std::vector<Node> children;
+};
+
+int main() {
+    ::reflpp::GenerateOptions opts;
+    opts.max_string_size = 8;
+    opts.max_container_size = 4;
+    opts.unicode_ratio = 0.2;
+
+    std::mt19937_64 rng(42);
+    auto user = ::reflpp::Generate<User>(rng, opts);
+
+    ::reflpp::json::CompactJsonFormatter s;
+    ::reflpp::json::ToJson(s, user);
+    std::cout << "The random user: " << s << std::endl;
+    REFLPP_ASSERT(user.scores.size() <= 4);
+
+    // the same seed produces the same value
+    std::mt19937_64 rng1(42);
+    REFLPP_ASSERT(::reflpp::Equal<User>{}(
+        user, ::reflpp::Generate<User>(rng1, opts)));
+
+    // the value is refilled in place, which reuses the allocated memory
+    ::reflpp::GenerateInto(rng, user, opts);
+
+    opts.min_container_size = 2;
+    opts.max_depth = 2;
+    auto root = ::reflpp::Generate<Node>(rng, opts);
+    REFLPP_ASSERT(root.children.size() >= 2);
+    REFLPP_ASSERT(root.children[0].children[0].children.empty());
+
+    return 0;
+}
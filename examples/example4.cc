@@ -0,0 +1,47 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the pretty json is written from the structural events, e.g., the empty
+// containers keep on one line
+
+struct Point {
+    int x;
+    int y;
+};
+
+struct Shape {
+    std::string name;
+    Point origin;
+    std::vector<int> sides;
+    std::map<std::string, std::string> tags;
+    std::vector<int> empty;
+    std::optional<double> area;
+};
+
+int main() {
+    Shape shape{
+        "triangle", {0, 0}, {3, 4, 5}, {{"color", "red"}}, {}, 6};
+
+    ::reflpp::json::PrettyJsonFormatter pretty;
+    ::reflpp::json::ToJson(pretty, shape);
+    std::cout << "Pretty json: " << std::endl << pretty << std::endl;
+
+    // the pretty json is parsed back to the same value as the compact one
+    Shape shape1;
+    auto ec = ::reflpp::json::FromJson(pretty, shape1);
+    REFLPP_ASSERT(!ec);
+
+    ::reflpp::json::CompactJsonFormatter compact, compact1;
+    ::reflpp::json::ToJson(compact, shape);
+    ::reflpp::json::ToJson(compact1, shape1);
+    REFLPP_ASSERT(compact == compact1);
+    std::cout << "Compact json: " << compact << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// the large containers are formatted by multiple threads, and the output is
+// byte-identical to ToJson
+
+struct Trade {
+    int id;
+    std::string symbol;
+    double price;
+};
+
+struct Batch {
+    std::string source;
+    std::vector<Trade> trades;
+};
+
+int main() {
+    Batch batch{"exchange", {}};
+    for (int i = 0; i < 100000; ++i) {
+        batch.trades.push_back({i, i % 2 ? "AAPL" : "MSFT", 100 + i * 0.25});
+    }
+
+    ::reflpp::json::ParallelOptions opts;
+    opts.threads = 4;
+    opts.min_chunk_size = 1024;
+
+    ::reflpp::json::CompactJsonFormatter parallel, serial;
+    ::reflpp::json::ToJsonParallel(parallel, batch, opts);
+    ::reflpp::json::ToJson(serial, batch);
+    REFLPP_ASSERT(parallel == serial);
+    std::cout << "Parallel json: " << parallel.size() << " bytes" << std::endl;
+
+    // the pretty formatter keeps the indent of the chunks
+    ::reflpp::json::PrettyJsonFormatter pretty, pretty_serial;
+    ::reflpp::json::ToJsonParallel(pretty, batch.trades, opts);
+    ::reflpp::json::FormatJsonValue(pretty_serial, batch.trades);
+    REFLPP_ASSERT(pretty == pretty_serial);
+
+    // the fixed buffer has no default storage, so that the chunks are
+    // formatted into the scratch strings, and copied into the buffer
+    std::vector<char> buf(serial.size());
+    ::reflpp::json::FixedJsonFormatter fixed(std::in_place,
+                                             std::span<char>(buf));
+    ::reflpp::json::ToJsonParallel(fixed, batch, opts);
+    REFLPP_ASSERT(!fixed.overflow());
+    REFLPP_ASSERT(std::string_view(fixed.data(), fixed.size()) == serial);
+    std::cout << "Parallel json into the fixed buffer: " << fixed.size()
+              << " bytes" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// the json is written into the caller-provided buffer without allocation, and
+// the required size is returned if the buffer is too small
+
+struct Order {
+    int id;
+    std::string side;
+    double price;
+    std::vector<int> fills;
+};
+
+int main() {
+    Order order{42, "buy", 99.5, {1, 2, 3}};
+
+    std::array<char, 128> buf;
+    std::size_t size = 0;
+    auto ec = ::reflpp::json::ToJson(buf, order, &size);
+    REFLPP_ASSERT(!ec);
+    std::cout << "Fixed buffer json: " << std::string_view(buf.data(), size)
+              << std::endl;
+
+    // notes, the written bytes are only the prefix of the output
+    std::array<char, 16> small;
+    ec = ::reflpp::json::ToJson(small, order, &size);
+    REFLPP_ASSERT(ec == ::reflpp::json::make_error(
+                            ::reflpp::json::kErrorBufferTooSmall));
+    std::cout << "Too small: " << ec.message() << ", " << size
+              << " bytes required" << std::endl;
+
+    // retries with the required size
+    std::vector<char> large(size);
+    ec = ::reflpp::json::ToJson(large, order, &size);
+    REFLPP_ASSERT(!ec && size == large.size());
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <array>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// the tracked object caches the json fragments of fields, and only the dirty
+// fields are formatted again
+
+struct Session {
+    int id;
+    std::string user;
+    std::vector<std::string> history;
+    double score;
+};
+
+int main() {
+    ::reflpp::Tracked<Session> session(Session{1, "alice", {"login"}, 0});
+
+    ::reflpp::json::CompactJsonFormatter s1;
+    ::reflpp::json::ToJson(s1, session);
+    REFLPP_ASSERT(!session.IsDirty());
+    std::cout << "First: " << s1 << std::endl;
+
+    // only the history and the score are formatted again
+    session.Mutable<2>().push_back("search");
+    session.Set<3>(1.5);
+    REFLPP_ASSERT(session.IsDirty(2) && session.IsDirty(3));
+    REFLPP_ASSERT(!session.IsDirty(0) && !session.IsDirty(1));
+
+    ::reflpp::json::CompactJsonFormatter s2;
+    ::reflpp::json::ToJson(s2, session);
+    std::cout << "Second: " << s2 << std::endl;
+
+    ::reflpp::json::CompactJsonFormatter plain;
+    ::reflpp::json::ToJson(plain, session.value());
+    REFLPP_ASSERT(s2 == plain);
+
+    // the fragments of the fixed buffer are formatted into the scratch
+    // strings, since the fixed buffer has no default storage
+    std::array<char, 256> buf;
+    ::reflpp::json::FixedJsonFormatter fixed(std::in_place,
+                                             std::span<char>(buf));
+    session.MarkDirty(1);
+    ::reflpp::json::ToJson(fixed, session);
+    REFLPP_ASSERT(!fixed.overflow());
+    REFLPP_ASSERT(std::string_view(fixed.data(), fixed.size()) == plain);
+    std::cout << "Fixed buffer: "
+              << std::string_view(fixed.data(), fixed.size()) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the messagepack codec, which encodes the struct as a map by default, or as
+// an array which requires the same field order on both sides
+
+struct Sample {
+    std::string sensor;
+    std::vector<double> values;
+    std::map<std::string, int> counters;
+    std::optional<std::string> note;
+};
+
+// the older version of Sample without the last two fields
+struct SampleV1 {
+    std::string sensor;
+    std::vector<double> values;
+};
+
+int main() {
+    Sample sample{"temp", {20.5, 21.0, 21.5}, {{"errors", 0}}, std::nullopt};
+
+    ::reflpp::msgpack::MapPacker map;
+    ::reflpp::msgpack::ToMsgPack(map, sample);
+
+    ::reflpp::msgpack::ArrayPacker array;
+    ::reflpp::msgpack::ToMsgPack(array, sample);
+    std::cout << "Map: " << map.size() << " bytes, array: " << array.size()
+              << " bytes" << std::endl;
+
+    Sample sample1;
+    auto ec = ::reflpp::msgpack::FromMsgPack(map, sample1);
+    REFLPP_ASSERT(!ec && sample1.values == sample.values);
+
+    ec = ::reflpp::msgpack::FromMsgPack(array, sample1);
+    REFLPP_ASSERT(!ec && sample1.counters == sample.counters);
+
+    // the numeric vectors are copied into the typed array ext as a whole
+    ::reflpp::msgpack::TypedArrayPacker<::reflpp::msgpack::kMap> typed;
+    ::reflpp::msgpack::ToMsgPack(typed, sample);
+    ec = ::reflpp::msgpack::FromMsgPack(typed, sample1);
+    REFLPP_ASSERT(!ec && sample1.values == sample.values);
+    std::cout << "Typed array: " << typed.size() << " bytes" << std::endl;
+
+    // the empty vector is the empty typed array
+    Sample empty{"none", {}, {}, std::nullopt};
+    ::reflpp::msgpack::TypedArrayPacker<::reflpp::msgpack::kMap> typed1;
+    ::reflpp::msgpack::ToMsgPack(typed1, empty);
+    ec = ::reflpp::msgpack::FromMsgPack(typed1, sample1);
+    REFLPP_ASSERT(!ec && sample1.sensor == "none" && sample1.values.empty());
+
+    // the unknown fields of the map are skipped
+    SampleV1 old;
+    ec = ::reflpp::msgpack::FromMsgPack(map, old);
+    REFLPP_ASSERT(!ec && old.sensor == "temp");
+
+    // the truncated input is rejected
+    std::string detail;
+    ec = ::reflpp::msgpack::FromMsgPack(
+        std::string_view(map).substr(0, map.size() - 1), sample1, &detail);
+    REFLPP_ASSERT(ec);
+    std::cout << "Truncated: " << detail << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <fmt/core.h>
+#include <reflpp.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// the cbor codec, see rfc 8949. the reader also accepts the indefinite-length
+// items, which are written by the streaming encoders
+
+struct Inner {
+    int a;
+};
+
+struct Message {
+    Inner inner;
+    int b;
+    std::vector<int> c;
+};
+
+// the newer version of Message, whose nested struct has more fields
+struct InnerV2 {
+    int a;
+    int x;
+    int y;
+};
+
+struct MessageV2 {
+    InnerV2 inner;
+    int b;
+    std::vector<int> c;
+};
+
+int main() {
+    Message msg{{1}, 2, {3, 4}};
+
+    ::reflpp::cbor::MapEncoder map;
+    ::reflpp::cbor::ToCbor(map, msg);
+
+    Message msg1{};
+    auto ec = ::reflpp::cbor::FromCbor(map, msg1);
+    REFLPP_ASSERT(!ec && msg1.inner.a == 1 && msg1.c == msg.c);
+    std::cout << "Map: " << map.size() << " bytes" << std::endl;
+
+    // the missing fields of the shorter array keep their values, and the
+    // fields after the nested struct are still matched by position
+    ::reflpp::cbor::ArrayEncoder array;
+    ::reflpp::cbor::ToCbor(array, msg);
+
+    MessageV2 msg2{{0, 7, 8}, 0, {}};
+    ec = ::reflpp::cbor::FromCbor(array, msg2);
+    REFLPP_ASSERT(!ec);
+    REFLPP_ASSERT(msg2.inner.a == 1 && msg2.inner.x == 7 && msg2.inner.y == 8);
+    REFLPP_ASSERT(msg2.b == 2 && msg2.c == msg.c);
+    std::cout << "Array: " << array.size() << " bytes" << std::endl;
+
+    // {_ "inner": {_ "a": 5}, "b": 6, "c": [_ 7, 8]}, i.e., the indefinite
+    // map and array end with the break byte 0xff
+    constexpr std::string_view kIndefinite =
+        "\xbf"
+        "\x65inner\xbf\x61" "a\x05\xff"
+        "\x61" "b\x06"
+        "\x61" "c\x9f\x07\x08\xff"
+        "\xff";
+    Message msg3{};
+    ec = ::reflpp::cbor::FromCbor(kIndefinite, msg3);
+    REFLPP_ASSERT(!ec && msg3.inner.a == 5 && msg3.b == 6);
+    REFLPP_ASSERT((msg3.c == std::vector<int>{7, 8}));
+    std::cout << "Indefinite: " << msg3.inner.a << ", " << msg3.b << ", ["
+              << msg3.c[0] << ", " << msg3.c[1] << "]" << std::endl;
+
+    // [_ [_ 5], 6], i.e., the indefinite arrays of the struct encoded as an
+    // array, and the missing fields keep their values
+    Message msg4{{0}, 0, {9}};
+    ec = ::reflpp::cbor::FromCbor("\x9f\x9f\x05\xff\x06\xff", msg4);
+    REFLPP_ASSERT(!ec && msg4.inner.a == 5 && msg4.b == 6);
+    REFLPP_ASSERT((msg4.c == std::vector<int>{9}));
+
+    return 0;
+}
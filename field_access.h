@@ -0,0 +1,303 @@
+#pragma once
+
+#include <field_name.h>
+#include <fields_count.h>
+#include <fingerprint.h>
+#include <for_each.h>
+#include <type_trait.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace reflpp {
+namespace _ {
+
+// whether the offsets of the fields can be measured by std::bit_cast, i.e.,
+// the struct is trivially copyable and made of the scalars only, which can
+// be the fields of the nested structs or the elements of the arrays
+template <typename T, typename = void>
+struct IsProbeableImpl
+    : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+template <typename T, std::size_t N>
+struct IsProbeableImpl<std::array<T, N>> : IsProbeableImpl<T> {};
+
+template <typename T, std::size_t... Is>
+consteval bool IsProbeableStruct(std::index_sequence<Is...>) {
+    return sizeof...(Is) > 0 &&
+           (IsProbeableImpl<std::remove_cv_t<FieldType<Is, T>>>::value && ...);
+}
+
+template <typename T>
+struct IsProbeableImpl<T, std::enable_if_t<IsAggregateStruct<T> &&
+                                           std::is_trivially_copyable_v<T>>>
+    : std::bool_constant<IsProbeableStruct<T>(
+          std::make_index_sequence<FieldsCount<T>()>{})> {};
+
+template <typename T>
+inline constexpr bool IsProbeable = IsProbeableImpl<T>::value;
+
+// whether any scalar of the value is nonzero
+template <typename T>
+constexpr bool IsNonZero(const T& value) {
+    if constexpr (IsAggregateStruct<T>) {
+        return VisitFields(value, [](const auto&... fields) {
+            return (IsNonZero(fields) || ...);
+        });
+    } else if constexpr (IsFixedArray<T>) {
+        for (const auto& v : value) {
+            if (IsNonZero(v)) return true;
+        }
+        return false;
+    } else {
+        return value != T{};
+    }
+}
+
+// the offset of the I-th field is the first byte, at or after the lower
+// bound, which changes the field once it's set. notes, the byte is set to 1,
+// which is a valid bool
+template <typename T, std::size_t I>
+consteval std::size_t MeasureFieldOffset(std::size_t lower) {
+    for (std::size_t k = lower; k < sizeof(T); ++k) {
+        std::array<unsigned char, sizeof(T)> bytes{};
+        bytes[k] = 1;
+        const auto obj = std::bit_cast<T>(bytes);
+        if (IsNonZero(GetField<I>(obj))) return k;
+    }
+    return sizeof(T);
+}
+
+template <std::size_t N>
+struct FieldLayout {
+    std::array<std::size_t, N> offsets{};
+
+    // whether the offsets are the real ones, see below
+    bool exact{false};
+
+    // whether the offsets are proven to be the real ones, rather than only
+    // consistent with the size and the alignment of the struct
+    bool proven{false};
+};
+
+// notes, the offsets are measured if the struct is probeable, otherwise they
+// follow the layout rules of the aggregate, i.e., the fields are placed in
+// order at the alignments of their types. the predicted offsets are exact if
+// the computed size and alignment match, which excludes the overlapped
+// fields, e.g., the empty fields with [[no_unique_address]], and the fields
+// with alignas which change the size or the alignment. they are proven only
+// if there's no padding at all, since alignas on a field could move it into
+// the padding without changing the size
+template <typename T, std::size_t... Is>
+consteval auto GetFieldLayoutImpl(std::index_sequence<Is...>) {
+    constexpr std::size_t N = sizeof...(Is);
+
+    FieldLayout<N> layout;
+    if constexpr (N > 0) {
+        constexpr std::array<std::size_t, N> aligns{
+            alignof(FieldType<Is, T>)...};
+        constexpr std::array<std::size_t, N> sizes{
+            sizeof(FieldType<Is, T>)...};
+
+        if constexpr (IsProbeable<T>) {
+            std::size_t end = 0;
+            ((layout.offsets[Is] =
+                  MeasureFieldOffset<T, Is>(AlignUp(end, aligns[Is])),
+              end = layout.offsets[Is] + sizes[Is]),
+             ...);
+            layout.exact = end <= sizeof(T);
+            layout.proven = layout.exact;
+        } else {
+            std::size_t end = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                layout.offsets[i] = AlignUp(end, aligns[i]);
+                end = layout.offsets[i] + sizes[i];
+            }
+            std::size_t align = *std::max_element(aligns.begin(), aligns.end());
+            layout.exact =
+                AlignUp(end, align) == sizeof(T) && align == alignof(T);
+            std::size_t bytes = 0;
+            for (std::size_t size : sizes) bytes += size;
+            layout.proven = bytes == sizeof(T);
+        }
+    } else {
+        layout.exact = true;
+        layout.proven = true;
+    }
+    return layout;
+}
+
+template <typename T>
+inline constexpr auto kFieldLayout =
+    GetFieldLayoutImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+// the accessors of fields, which take the address of the struct and return
+// the address of the field
+template <typename T, std::size_t... Is>
+consteval auto GetFieldAccessorsImpl(std::index_sequence<Is...>) {
+    using Accessor = void* (*)(void*);
+    return std::array<Accessor, sizeof...(Is)>{+[](void* obj) -> void* {
+        return std::addressof(GetField<Is>(*static_cast<T*>(obj)));
+    }...};
+}
+
+template <typename T>
+inline constexpr auto kFieldAccessors =
+    GetFieldAccessorsImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+// the identity of the type without rtti
+template <typename T>
+inline constexpr char kTypeTag = 0;
+
+using TypeId = const void*;
+
+template <typename T>
+constexpr TypeId GetTypeId() {
+    return &kTypeTag<RemoveCVRef<T>>;
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldTypeIdsImpl(std::index_sequence<Is...>) {
+    return std::array<TypeId, sizeof...(Is)>{GetTypeId<FieldType<Is, T>>()...};
+}
+
+template <typename T>
+inline constexpr auto kFieldTypeIds =
+    GetFieldTypeIdsImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+// the open addressing table from the field names to the indexes. notes, the
+// table is at most half full, so that the probe sequences are short
+template <std::size_t N>
+struct NameTable {
+    static constexpr std::size_t kSize =
+        std::bit_ceil(std::max<std::size_t>(2 * N, 2));
+
+    std::array<int, kSize> slots{};
+};
+
+template <const auto& names>
+consteval auto GetNameTable() {
+    using Table = NameTable<names.size()>;
+
+    Table table;
+    table.slots.fill(-1);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        std::size_t slot = HashBytes(kFnvOffsetBasis, names[i]);
+        for (;; ++slot) {
+            slot &= Table::kSize - 1;
+            if (table.slots[slot] < 0) break;
+        }
+        table.slots[slot] = static_cast<int>(i);
+    }
+    return table;
+}
+
+template <typename T>
+inline constexpr auto kNameTable = GetNameTable<kFieldNames<T>>();
+
+template <std::size_t N>
+constexpr std::optional<std::size_t> FindName(
+    const std::array<std::string_view, N>& names, const NameTable<N>& table,
+    std::string_view name) {
+    constexpr std::size_t kMask = NameTable<N>::kSize - 1;
+
+    for (std::size_t slot = HashBytes(kFnvOffsetBasis, name);; ++slot) {
+        int idx = table.slots[slot & kMask];
+        if (idx < 0) return std::nullopt;
+        if (names[idx] == name) return idx;
+    }
+}
+
+}  // namespace _
+
+// the offsets of fields in bytes, see _::GetFieldLayoutImpl
+template <typename T>
+consteval auto GetFieldOffsets() {
+    constexpr auto& layout = _::kFieldLayout<T>;
+    static_assert(layout.exact, "The field offsets are not determined");
+    return layout.offsets;
+}
+
+template <typename T>
+inline constexpr auto kFieldOffsets = GetFieldOffsets<T>();
+
+// returns the index of the field by name in constant time
+template <typename T>
+constexpr std::optional<std::size_t> FindFieldIndex(std::string_view name) {
+    return _::FindName(kFieldNames<T>, _::kNameTable<T>, name);
+}
+
+// the type-erased reference to the field, which is null if the field is not
+// found. the value is accessed with the exact type of the field
+template <bool Const>
+class FieldRef {
+   public:
+    using Pointer = std::conditional_t<Const, const void*, void*>;
+
+    FieldRef() = default;
+    FieldRef(Pointer ptr, _::TypeId type) : ptr_(ptr), type_(type) {}
+
+    // the const reference is converted from the mutable one
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    FieldRef(const FieldRef<false>& other)
+        : ptr_(other.ptr_), type_(other.type_) {}
+
+   public:
+    explicit operator bool() const { return ptr_ != nullptr; }
+
+    Pointer data() const { return ptr_; }
+
+    template <typename U>
+    bool Is() const {
+        return ptr_ && type_ == _::GetTypeId<U>();
+    }
+
+    // returns nullptr if the field is not the type
+    template <typename U>
+    auto* As() const {
+        using P = std::conditional_t<Const, const U*, U*>;
+        return Is<U>() ? static_cast<P>(ptr_) : nullptr;
+    }
+
+   private:
+    friend class FieldRef<!Const>;
+
+    Pointer ptr_{nullptr};
+    _::TypeId type_{nullptr};
+};
+
+// returns the i-th field through the accessor table, which is null if the
+// index is out of range
+template <typename T,
+          std::enable_if_t<IsAggregateStruct<std::remove_cv_t<T>>, int> _ = 0>
+FieldRef<std::is_const_v<T>> GetField(T& obj, std::size_t i) {
+    using U = std::remove_cv_t<T>;
+
+    constexpr auto& accessors = _::kFieldAccessors<U>;
+    if (i >= accessors.size()) {
+        return {};
+    }
+
+    // notes, the constness is added back by the FieldRef
+    void* ptr = const_cast<U*>(std::addressof(obj));
+    return {accessors[i](ptr), _::kFieldTypeIds<U>[i]};
+}
+
+// returns the field by name, which is null if not found
+template <typename T,
+          std::enable_if_t<IsAggregateStruct<std::remove_cv_t<T>>, int> _ = 0>
+FieldRef<std::is_const_v<T>> GetField(T& obj, std::string_view name) {
+    auto idx = FindFieldIndex<std::remove_cv_t<T>>(name);
+    return idx ? GetField(obj, *idx) : FieldRef<std::is_const_v<T>>();
+}
+
+}  // namespace reflpp
@@ -28,8 +28,15 @@ constexpr std::string_view ExtractFieldName(
         return {};
     }
 
-    auto domain_start = type_str.find(kDomainDesc, start);
-    if (start == std::string_view::npos) {
+    // e.g., "(& FakeObject<ns::Foo>.ns::Foo::a)", the field name follows the
+    // last domain descriptor, since the type may have namespaces
+    auto domain_end = type_str.rfind(')');
+    if (domain_end == std::string_view::npos || domain_end < start) {
+        return {};
+    }
+
+    auto domain_start = type_str.rfind(kDomainDesc, domain_end);
+    if (domain_start == std::string_view::npos || domain_start < start) {
         return {};
     }
     domain_start += 2;  // skip domain descriptor
@@ -59,12 +66,12 @@ consteval auto GetFieldNamesImpl(std::index_sequence<Is...>) {
     if constexpr (N == 0) {
         return std::array<std::string_view, N>{};
     } else {
-        constexpr auto tup = TieAsTuple<T, N>(FakeObject<T>);
+        constexpr auto fields = TieFields<T, N>(FakeObject<T>);
 
         std::array<std::string_view, N> field_names;
 
-        ((field_names[Is] =
-              ExtractFieldName(TypeToString<std::get<Is>(tup)>())),
+        ((field_names[Is] = ExtractFieldName(
+              TypeToString<WorkaroundWrap(Pick<Is>(fields))>())),
          ...);
 
         return field_names;
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <field_access.h>
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// the flattened paths of fields, which recurse into the nested aggregate
+// structs, e.g., {"foo.a", "foo.b", ..., "foo.j", "f64", "str"} for Bar in
+// README. the paths are ordered as the fields, and only the leaves, i.e., the
+// fields other than the aggregate structs, have paths
+namespace reflpp {
+namespace _ {
+
+struct FieldPathStats {
+    // the number of paths
+    std::size_t count{0};
+    // the total length of paths
+    std::size_t chars{0};
+    // the max depth of paths
+    std::size_t depth{0};
+};
+
+template <typename T>
+consteval FieldPathStats GetFieldPathStats();
+
+template <typename F>
+consteval FieldPathStats GetLeafStats(std::string_view name) {
+    if constexpr (IsAggregateStruct<F>) {
+        auto stats = GetFieldPathStats<F>();
+        // each path has the prefix and the dot
+        stats.chars += stats.count * (name.size() + 1);
+        stats.depth += 1;
+        return stats;
+    } else {
+        return {1, name.size(), 1};
+    }
+}
+
+template <typename T, std::size_t... Is>
+consteval FieldPathStats GetFieldPathStatsImpl(std::index_sequence<Is...>) {
+    FieldPathStats stats;
+    if constexpr (sizeof...(Is) > 0) {
+        const FieldPathStats fields[] = {
+            GetLeafStats<FieldType<Is, T>>(kFieldNames<T>[Is])...};
+        for (const auto& f : fields) {
+            stats.count += f.count;
+            stats.chars += f.chars;
+            stats.depth = std::max(stats.depth, f.depth);
+        }
+    }
+    return stats;
+}
+
+template <typename T>
+consteval FieldPathStats GetFieldPathStats() {
+    return GetFieldPathStatsImpl<T>(
+        std::make_index_sequence<FieldsCount<T>()>{});
+}
+
+// notes, all paths are stored in one buffer of chars
+template <std::size_t M, std::size_t L, std::size_t D>
+struct FieldPathTable {
+    std::array<char, L> chars{};
+    std::array<std::size_t, M> begins{};
+    std::array<std::size_t, M> sizes{};
+
+    // the field indexes from the root
+    std::array<std::array<std::size_t, D>, M> indexes{};
+    std::array<std::size_t, M> depths{};
+};
+
+template <std::size_t M, std::size_t L, std::size_t D>
+struct FieldPathBuilder {
+    FieldPathTable<M, L, D> table;
+
+    // the fields from the root to the current one
+    std::array<std::size_t, D> indexes{};
+    std::array<std::string_view, D> names{};
+    std::size_t depth{0};
+
+    std::size_t count{0};
+    std::size_t cursor{0};
+
+    constexpr void AddLeaf() {
+        table.begins[count] = cursor;
+        for (std::size_t i = 0; i < depth; ++i) {
+            if (i > 0) table.chars[cursor++] = '.';
+            for (char ch : names[i]) {
+                table.chars[cursor++] = ch;
+            }
+        }
+        table.sizes[count] = cursor - table.begins[count];
+        table.indexes[count] = indexes;
+        table.depths[count] = depth;
+        ++count;
+    }
+};
+
+template <typename T, typename Builder, std::size_t... Is>
+consteval void CollectFieldPaths(Builder& b, std::index_sequence<Is...>);
+
+template <typename F, typename Builder>
+consteval void CollectFieldPath(Builder& b, std::size_t idx,
+                                std::string_view name) {
+    b.indexes[b.depth] = idx;
+    b.names[b.depth] = name;
+    ++b.depth;
+    if constexpr (IsAggregateStruct<F>) {
+        CollectFieldPaths<F>(b, std::make_index_sequence<FieldsCount<F>()>{});
+    } else {
+        b.AddLeaf();
+    }
+    --b.depth;
+}
+
+template <typename T, typename Builder, std::size_t... Is>
+consteval void CollectFieldPaths(Builder& b, std::index_sequence<Is...>) {
+    (CollectFieldPath<FieldType<Is, T>>(b, Is, kFieldNames<T>[Is]), ...);
+}
+
+template <typename T>
+consteval auto GetFieldPathTable() {
+    constexpr auto stats = GetFieldPathStats<T>();
+
+    FieldPathBuilder<stats.count, stats.chars, stats.depth> b;
+    CollectFieldPaths<T>(b, std::make_index_sequence<FieldsCount<T>()>{});
+    return b.table;
+}
+
+template <typename T>
+inline constexpr auto kFieldPathTable = GetFieldPathTable<T>();
+
+template <typename T, std::size_t I, std::size_t D = 0, typename U>
+constexpr auto& GetFieldByPathImpl(U& obj) {
+    constexpr auto& table = kFieldPathTable<T>;
+    if constexpr (D == table.depths[I]) {
+        return obj;
+    } else {
+        return GetFieldByPathImpl<T, I, D + 1>(
+            GetField<table.indexes[I][D]>(obj));
+    }
+}
+
+}  // namespace _
+
+template <typename T>
+consteval auto GetFieldPaths() {
+    constexpr auto& table = _::kFieldPathTable<T>;
+    constexpr std::size_t M = table.sizes.size();
+
+    std::array<std::string_view, M> paths;
+    for (std::size_t i = 0; i < M; ++i) {
+        paths[i] = {table.chars.data() + table.begins[i], table.sizes[i]};
+    }
+    return paths;
+}
+
+template <typename T>
+inline constexpr auto kFieldPaths = GetFieldPaths<T>();
+
+// returns the reference to the field of the I-th path, the constness follows
+// the object
+template <std::size_t I, typename T>
+constexpr auto& GetFieldByPath(T& obj) {
+    using U = std::remove_cv_t<T>;
+    static_assert(I < kFieldPaths<U>.size(), "Index out of range");
+    return _::GetFieldByPathImpl<U, I>(obj);
+}
+
+// the declared type of the field of the I-th path
+template <std::size_t I, typename T>
+using FieldPathType =
+    std::remove_reference_t<decltype(GetFieldByPath<I>(std::declval<T&>()))>;
+
+namespace _ {
+
+template <typename T>
+inline constexpr auto kPathTable = GetNameTable<kFieldPaths<T>>();
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldPathTypeIds(std::index_sequence<Is...>) {
+    return std::array<TypeId, sizeof...(Is)>{
+        GetTypeId<FieldPathType<Is, T>>()...};
+}
+
+template <typename T>
+inline constexpr auto kFieldPathTypeIds = GetFieldPathTypeIds<T>(
+    std::make_index_sequence<kFieldPaths<T>.size()>{});
+
+using FieldAccessor = void* (*)(void*);
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldPathAccessors(std::index_sequence<Is...>) {
+    return std::array<FieldAccessor, sizeof...(Is)>{+[](void* obj) -> void* {
+        return std::addressof(GetFieldByPath<Is>(*static_cast<T*>(obj)));
+    }...};
+}
+
+template <typename T>
+inline constexpr auto kFieldPathAccessors = GetFieldPathAccessors<T>(
+    std::make_index_sequence<kFieldPaths<T>.size()>{});
+
+template <typename T, typename F, std::size_t... Is>
+constexpr void ForEachFieldPathImpl(T& obj, F&& f, std::index_sequence<Is...>) {
+    (f(std::integral_constant<std::size_t, Is>{}, GetFieldByPath<Is>(obj)),
+     ...);
+}
+
+}  // namespace _
+
+// returns the index of the path in constant time
+template <typename T>
+constexpr std::optional<std::size_t> FindFieldPath(std::string_view path) {
+    return _::FindName(kFieldPaths<T>, _::kPathTable<T>, path);
+}
+
+// calls the function with the index of path and the field for each path,
+// e.g., ForEachFieldPath(obj, [](auto idx, const auto& field) {
+//     std::cout << kFieldPaths<T>[idx] << "=" << field;
+// });
+template <typename T, typename F>
+constexpr void ForEachFieldPath(T& obj, F&& f) {
+    using U = std::remove_cv_t<T>;
+    _::ForEachFieldPathImpl(obj, f,
+                            std::make_index_sequence<kFieldPaths<U>.size()>{});
+}
+
+// returns the field of the i-th path, which is null if the index is out of
+// range
+template <typename T,
+          std::enable_if_t<IsAggregateStruct<std::remove_cv_t<T>>, int> _ = 0>
+FieldRef<std::is_const_v<T>> GetFieldByPath(T& obj, std::size_t i) {
+    using U = std::remove_cv_t<T>;
+
+    constexpr auto& accessors = _::kFieldPathAccessors<U>;
+    if (i >= accessors.size()) {
+        return {};
+    }
+
+    // notes, the constness is restored by FieldRef
+    void* base = const_cast<U*>(std::addressof(obj));
+    return {accessors[i](base), _::kFieldPathTypeIds<U>[i]};
+}
+
+// returns the field by path, e.g., "foo.a", which is null if not found
+template <typename T,
+          std::enable_if_t<IsAggregateStruct<std::remove_cv_t<T>>, int> _ = 0>
+FieldRef<std::is_const_v<T>> GetFieldByPath(T& obj, std::string_view path) {
+    auto idx = FindFieldPath<std::remove_cv_t<T>>(path);
+    return idx ? GetFieldByPath(obj, *idx) : FieldRef<std::is_const_v<T>>();
+}
+
+}  // namespace reflpp
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace reflpp {
+namespace _ {
+
+// the recursive type, e.g., the tree node, is cut off at the depth
+inline constexpr int kMaxFingerprintDepth = 32;
+
+inline constexpr std::uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+inline constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+// the 64-bit FNV-1a hash
+constexpr std::uint64_t HashBytes(std::uint64_t h, std::string_view bytes) {
+    for (char ch : bytes) {
+        h ^= static_cast<std::uint8_t>(ch);
+        h *= kFnvPrime;
+    }
+    return h;
+}
+
+constexpr std::uint64_t HashInt(std::uint64_t h, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        h ^= (v >> (i * 8)) & 0xff;
+        h *= kFnvPrime;
+    }
+    return h;
+}
+
+template <typename T, int Depth>
+consteval std::uint64_t Fingerprint();
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t FingerprintFields(std::uint64_t h,
+                                          std::index_sequence<Is...>) {
+    constexpr auto& names = kFieldNames<T>;
+    ((h = HashInt(HashBytes(h, names[Is]),
+                  Fingerprint<FieldType<Is, T>, Depth + 1>())),
+     ...);
+    return h;
+}
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t FingerprintElements(std::uint64_t h,
+                                            std::index_sequence<Is...>) {
+    ((h = HashInt(h, Fingerprint<std::tuple_element_t<Is, T>, Depth + 1>())),
+     ...);
+    return h;
+}
+
+template <typename T, int Depth, std::size_t... Is>
+consteval std::uint64_t FingerprintAlternatives(std::uint64_t h,
+                                                std::index_sequence<Is...>) {
+    ((h = HashInt(h,
+                  Fingerprint<std::variant_alternative_t<Is, T>, Depth + 1>())),
+     ...);
+    return h;
+}
+
+// the fingerprint depends on the kind, the size and the nesting of types, and
+// the names of fields. notes, the name of the struct itself is excluded, and
+// the types with the same encoding share the kind, e.g., std::vector and
+// std::list, std::string and std::string_view
+template <typename T, int Depth>
+consteval std::uint64_t Fingerprint() {
+    using U = RemoveCVRef<T>;
+
+    std::uint64_t h = kFnvOffsetBasis;
+    if constexpr (Depth > kMaxFingerprintDepth) {
+        return HashBytes(h, "recursive");
+    } else if constexpr (IsBool<U>) {
+        return HashBytes(h, "bool");
+    } else if constexpr (IsChar<U>) {
+        return HashInt(HashBytes(h, "char"), sizeof(U));
+    } else if constexpr (IsIntegral<U>) {
+        h = HashBytes(h, std::is_signed_v<U> ? "int" : "uint");
+        return HashInt(h, sizeof(U));
+    } else if constexpr (IsFloat<U>) {
+        return HashInt(HashBytes(h, "float"), sizeof(U));
+    } else if constexpr (IsEnum<U>) {
+        using I = std::underlying_type_t<U>;
+        return HashInt(HashBytes(h, "enum"), Fingerprint<I, Depth + 1>());
+    } else if constexpr (IsStringLike<U>) {
+        using C = typename U::value_type;
+        return HashInt(HashBytes(h, "string"), Fingerprint<C, Depth + 1>());
+    } else if constexpr (IsMapContainer<U>) {
+        using K = typename U::key_type;
+        using V = typename U::mapped_type;
+        h = HashInt(HashBytes(h, "map"), Fingerprint<K, Depth + 1>());
+        return HashInt(h, Fingerprint<V, Depth + 1>());
+    } else if constexpr (IsSetContainer<U>) {
+        using E = typename U::value_type;
+        return HashInt(HashBytes(h, "set"), Fingerprint<E, Depth + 1>());
+    } else if constexpr (IsSequenceContainer<U>) {
+        using E = typename U::value_type;
+        return HashInt(HashBytes(h, "sequence"), Fingerprint<E, Depth + 1>());
+    } else if constexpr (IsOptional<U>) {
+        using E = typename U::value_type;
+        return HashInt(HashBytes(h, "optional"), Fingerprint<E, Depth + 1>());
+    } else if constexpr (IsSmartPtr<U>) {
+        using E = typename U::element_type;
+        return HashInt(HashBytes(h, "optional"), Fingerprint<E, Depth + 1>());
+    } else if constexpr (IsFixedArray<U>) {
+        using E = RemoveCVRef<decltype(std::declval<U&>()[0])>;
+        h = HashInt(HashBytes(h, "array"), sizeof(U) / sizeof(E));
+        return HashInt(h, Fingerprint<E, Depth + 1>());
+    } else if constexpr (IsTuple<U>) {
+        constexpr std::size_t N = std::tuple_size_v<U>;
+        h = HashInt(HashBytes(h, "tuple"), N);
+        return FingerprintElements<U, Depth>(h, std::make_index_sequence<N>{});
+    } else if constexpr (IsVariant<U>) {
+        constexpr std::size_t N = std::variant_size_v<U>;
+        h = HashInt(HashBytes(h, "variant"), N);
+        return FingerprintAlternatives<U, Depth>(h,
+                                                 std::make_index_sequence<N>{});
+    } else {
+        static_assert(IsAggregateStruct<U>, "Unsupported type");
+
+        constexpr std::size_t N = FieldsCount<U>();
+        h = HashInt(HashBytes(h, "struct"), N);
+        return FingerprintFields<U, Depth>(h, std::make_index_sequence<N>{});
+    }
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldFingerprintsImpl(std::index_sequence<Is...>) {
+    constexpr auto& names = kFieldNames<T>;
+    return std::array<std::uint64_t, sizeof...(Is)>{
+        HashInt(HashBytes(kFnvOffsetBasis, names[Is]),
+                Fingerprint<FieldType<Is, T>, 1>())...};
+}
+
+}  // namespace _
+
+// the 64-bit fingerprint of the type, which is computed at compile time.
+// the types with the same fingerprint have the same binary encoding
+template <typename T>
+inline constexpr std::uint64_t kFingerprint = _::Fingerprint<T, 0>();
+
+// the fingerprints of fields, which combine the name and the type of each
+// field, so that the fields can be matched across versions of the struct
+template <typename T>
+inline constexpr auto kFieldFingerprints = _::GetFieldFingerprintsImpl<T>(
+    std::make_index_sequence<FieldsCount<T>()>{});
+
+}  // namespace reflpp
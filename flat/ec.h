@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+#define FLAT_ERROR_LIST(__)                               \
+    __(kOk, "OK")                                         \
+    __(kErrorUnexpectedTerminate, "Unexpected terminate") \
+    __(kErrorOutOfBounds, "Out of bounds")                \
+    __(kErrorDepthLimit, "Depth limit exceeded")
+
+namespace reflpp {
+namespace flat {
+
+// clang-format off
+enum ErrorCode {
+#define __(A, B) A,
+    FLAT_ERROR_LIST(__)
+#undef __
+};
+// clang-format on
+
+struct FlatErrorCategory : public std::error_category {
+    const char* name() const noexcept override { return "flat error"; }
+
+    // clang-format off
+    std::string message(int ec) const override {
+        switch (ec) {
+#define __(A, B) case A: return B;
+        FLAT_ERROR_LIST(__)
+#undef __
+        }
+        return "unknown error code";
+    }
+    // clang-format on
+};
+
+inline const FlatErrorCategory error_category;
+
+inline std::error_code make_error(int ec) { return {ec, error_category}; }
+
+}  // namespace flat
+}  // namespace reflpp
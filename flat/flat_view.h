@@ -0,0 +1,477 @@
+#pragma once
+
+#include <byte_order.h>
+#include <flat/ec.h>
+#include <flat/flat_writer.h>
+#include <for_each.h>
+#include <type_trait.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace reflpp {
+namespace flat {
+
+template <typename T>
+class View;
+
+template <typename T, bool Inline = false>
+class VectorView;
+
+namespace _ {
+
+// the depth limit of the nested objects, which prevents the stack overflow
+// from the malformed buffer with cycles
+inline constexpr int kMaxDepth = 64;
+
+inline Offset LoadOffset(const char* p) {
+    return LoadLittleEndian<Offset>(p);
+}
+
+// returns the view of the slot. scalars are returned by value, and strings
+// are returned as std::string_view, which refer to the buffer
+template <typename T>
+auto Read(const char* base, const char* p) {
+    using U = RemoveCVRef<T>;
+
+    if constexpr (IsBool<U>) {
+        return *p != 0;
+    } else if constexpr (IsEnum<U>) {
+        using I = std::underlying_type_t<U>;
+        return static_cast<U>(Read<I>(base, p));
+    } else if constexpr (binary::_::IsScalar<U>) {
+        return LoadLittleEndian<U>(p);
+    } else if constexpr (IsStringLike<U>) {
+        using CharType = typename U::value_type;
+        static_assert(sizeof(CharType) == 1,
+                      "Only the narrow string is supported");
+
+        const char* obj = base + LoadOffset(p);
+        return std::basic_string_view<CharType>(
+            reinterpret_cast<const CharType*>(obj + kOffsetSize),
+            LoadOffset(obj));
+    } else if constexpr (IsOptional<U> || IsSmartPtr<U>) {
+        using V = RemoveCVRef<decltype(*std::declval<U&>())>;
+        using R = decltype(Read<V>(base, p));
+
+        auto off = LoadOffset(p);
+        return off ? std::optional<R>(Read<V>(base, base + off))
+                   : std::optional<R>();
+    } else if constexpr (IsOutOfLine<U>) {
+        const char* obj = base + LoadOffset(p);
+        return VectorView<ElementType<U>>(base, obj + kOffsetSize,
+                                          LoadOffset(obj));
+    } else if constexpr (IsFixedArray<U>) {
+        using E = RemoveCVRef<decltype(std::declval<U&>()[0])>;
+        return VectorView<E, true>(base, p, sizeof(U) / sizeof(E));
+    } else if constexpr (IsPair<U>) {
+        using K = typename U::first_type;
+        using V = typename U::second_type;
+        return std::make_pair(Read<K>(base, p),
+                              Read<V>(base, p + kSlotSize<K>));
+    } else {
+        static_assert(IsAggregateStruct<U>, "Unsupported type");
+        return View<U>(base, p);
+    }
+}
+
+template <typename T>
+using ReadType = decltype(Read<T>(nullptr, nullptr));
+
+// copies the slot into the value
+template <typename T>
+void Load(const char* base, const char* p, T& value) {
+    if constexpr (IsTrivialSlot<T>) {
+        std::memcpy(std::addressof(value), p, sizeof(T));
+    } else if constexpr (IsBool<T> || binary::_::IsScalar<T>) {
+        value = Read<T>(base, p);
+    } else if constexpr (IsOptional<T> || IsSmartPtr<T>) {
+        using V = RemoveCVRef<decltype(*value)>;
+
+        auto off = LoadOffset(p);
+        if (!off) {
+            value = {};
+            return;
+        }
+
+        if constexpr (IsOptional<T>) {
+            Load(base, base + off, value.emplace());
+        } else if constexpr (IsUniquePtr<T>) {
+            value = std::make_unique<V>();
+            Load(base, base + off, *value);
+        } else {
+            value = std::make_shared<V>();
+            Load(base, base + off, *value);
+        }
+    } else if constexpr (IsOutOfLine<T>) {
+        using E = ElementType<T>;
+
+        const char* obj = base + LoadOffset(p);
+        auto n = LoadOffset(obj);
+        obj += kOffsetSize;
+
+        if constexpr (IsStringView<T>) {
+            value = Read<T>(base, p);
+        } else if constexpr (IsTrivialSlot<E> &&
+                             (IsString<T> || IsTemplateOf<std::vector, T>)) {
+            value.resize(n);
+            if (n > 0) {
+                std::memcpy(value.data(), obj, n * sizeof(E));
+            }
+        } else {
+            value.clear();
+            for (std::size_t i = 0; i < n; ++i, obj += kSlotSize<E>) {
+                E e{};
+                Load(base, obj, e);
+                if constexpr (IsSequenceContainer<T>) {
+                    value.push_back(std::move(e));
+                } else {
+                    value.insert(std::move(e));
+                }
+            }
+        }
+    } else if constexpr (IsFixedArray<T>) {
+        for (auto& e : value) {
+            Load(base, p, e);
+            p += kSlotSize<decltype(e)>;
+        }
+    } else if constexpr (IsPair<T>) {
+        Load(base, p, value.first);
+        Load(base, p + kSlotSize<decltype(value.first)>, value.second);
+    } else {
+        static_assert(IsAggregateStruct<T>, "Unsupported type");
+
+        ForEach(value, [base, p](auto idx, auto& field) {
+            Load(base, p + kSlotOffsets<T>[idx], field);
+        });
+    }
+}
+
+// whether the slot refers to the out-of-line objects, which are verified
+template <typename T, typename = void>
+struct HasOffsetImpl : std::false_type {};
+
+template <typename T>
+inline constexpr bool HasOffset = HasOffsetImpl<RemoveCVRef<T>>::value;
+
+template <typename T>
+struct HasOffsetImpl<T, std::enable_if_t<IsOutOfLine<T>>> : std::true_type {};
+
+template <typename T, std::size_t N>
+struct HasOffsetImpl<T[N]> : HasOffsetImpl<T> {};
+
+template <typename T, std::size_t N>
+struct HasOffsetImpl<std::array<T, N>> : HasOffsetImpl<T> {};
+
+template <typename K, typename V>
+struct HasOffsetImpl<std::pair<K, V>>
+    : std::bool_constant<HasOffset<K> || HasOffset<V>> {};
+
+template <typename T, std::size_t... Is>
+consteval bool HasOffsetField(std::index_sequence<Is...>) {
+    return (HasOffset<FieldType<Is, T>> || ...);
+}
+
+template <typename T>
+struct HasOffsetImpl<T, std::enable_if_t<IsAggregateStruct<T>>>
+    : std::bool_constant<HasOffsetField<T>(
+          std::make_index_sequence<FieldsCount<T>()>{})> {};
+
+struct Verifier {
+    const char* base;
+    std::size_t size;
+    int depth{0};
+    int ec{kOk};
+
+    bool E(int code) {
+        if (ec == kOk) {
+            ec = code;
+        }
+        return false;
+    }
+
+    // checks the out-of-line object, which is `n` bytes at the offset
+    bool Check(Offset off, std::size_t n) {
+        if (off > size || size - off < n) {
+            return E(kErrorOutOfBounds);
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool Verify(const char* p);
+
+    template <typename T, std::size_t... Is>
+    bool VerifyFields(const char* p, std::index_sequence<Is...>) {
+        return (Verify<FieldType<Is, T>>(p + kSlotOffsets<T>[Is]) && ...);
+    }
+
+    template <typename T>
+    bool VerifyElements(const char* p, std::size_t n) {
+        if constexpr (HasOffset<T>) {
+            for (std::size_t i = 0; i < n; ++i, p += kSlotSize<T>) {
+                if (!Verify<T>(p)) return false;
+            }
+        }
+        return true;
+    }
+};
+
+// notes, the slot itself has been checked by the parent
+template <typename T>
+bool Verifier::Verify(const char* p) {
+    using U = RemoveCVRef<T>;
+
+    if constexpr (!HasOffset<U>) {
+        return true;
+    } else if constexpr (IsOutOfLine<U>) {
+        auto off = LoadOffset(p);
+        if (off == 0 && (IsOptional<U> || IsSmartPtr<U>)) {
+            return true;
+        }
+
+        if (depth >= kMaxDepth) {
+            return E(kErrorDepthLimit);
+        }
+
+        bool ok = false;
+        ++depth;
+        if constexpr (IsOptional<U> || IsSmartPtr<U>) {
+            using V = RemoveCVRef<decltype(*std::declval<U&>())>;
+            ok = Check(off, kSlotSize<V>) && Verify<V>(base + off);
+        } else {
+            using Elem = ElementType<U>;
+            if (Check(off, kOffsetSize)) {
+                auto n = LoadOffset(base + off);
+                auto elems = off + kOffsetSize;
+                constexpr std::size_t slot = std::max<std::size_t>(
+                    kSlotSize<Elem>, 1);
+                ok = n <= (size - elems) / slot &&
+                     VerifyElements<Elem>(base + elems, n);
+                if (!ok) E(kErrorOutOfBounds);
+            }
+        }
+        --depth;
+        return ok;
+    } else if constexpr (IsFixedArray<U>) {
+        using Elem = RemoveCVRef<decltype(std::declval<U&>()[0])>;
+        return VerifyElements<Elem>(p, sizeof(U) / sizeof(Elem));
+    } else if constexpr (IsPair<U>) {
+        using K = typename U::first_type;
+        using V = typename U::second_type;
+        return Verify<K>(p) && Verify<V>(p + kSlotSize<K>);
+    } else {
+        constexpr std::size_t N = FieldsCount<U>();
+        return VerifyFields<U>(p, std::make_index_sequence<N>{});
+    }
+}
+
+}  // namespace _
+
+// VectorView is the read-only view of strings, containers and fixed arrays.
+// notes, the map is viewed as the sequence of key-value pairs, and the fixed
+// arrays are Inline, whose slots are packed without alignment
+template <typename T, bool Inline>
+class VectorView {
+   public:
+    using value_type = _::ReadType<T>;
+    using size_type = std::size_t;
+
+    // the random access iterator, which keeps the index of the element and
+    // reads it from its slot
+    class iterator {
+       public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = VectorView::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        // notes, the elements are read by value
+        using reference = value_type;
+
+        iterator() = default;
+        iterator(const char* base, const char* p, difference_type idx)
+            : base_(base), p_(p), idx_(idx) {}
+
+        reference operator*() const { return (*this)[0]; }
+
+        reference operator[](difference_type n) const {
+            return _::Read<T>(base_, p_ + (idx_ + n) * _::kSlotSize<T>);
+        }
+
+        iterator& operator++() {
+            ++idx_;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto itr = *this;
+            ++*this;
+            return itr;
+        }
+
+        iterator& operator--() {
+            --idx_;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto itr = *this;
+            --*this;
+            return itr;
+        }
+
+        iterator& operator+=(difference_type n) {
+            idx_ += n;
+            return *this;
+        }
+
+        iterator& operator-=(difference_type n) {
+            idx_ -= n;
+            return *this;
+        }
+
+        friend iterator operator+(iterator itr, difference_type n) {
+            return itr += n;
+        }
+
+        friend iterator operator+(difference_type n, iterator itr) {
+            return itr += n;
+        }
+
+        friend iterator operator-(iterator itr, difference_type n) {
+            return itr -= n;
+        }
+
+        friend difference_type operator-(const iterator& a,
+                                         const iterator& b) {
+            return a.idx_ - b.idx_;
+        }
+
+        bool operator==(const iterator& other) const {
+            return idx_ == other.idx_;
+        }
+
+        auto operator<=>(const iterator& other) const {
+            return idx_ <=> other.idx_;
+        }
+
+       private:
+        const char* base_{nullptr};
+        const char* p_{nullptr};
+        difference_type idx_{0};
+    };
+
+    VectorView() = default;
+    VectorView(const char* base, const char* p, size_type n)
+        : base_(base), p_(p), size_(n) {}
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    value_type operator[](size_type idx) const {
+        return _::Read<T>(base_, p_ + idx * _::kSlotSize<T>);
+    }
+
+    iterator begin() const { return iterator(base_, p_, 0); }
+    iterator end() const {
+        return iterator(base_, p_, static_cast<std::ptrdiff_t>(size_));
+    }
+
+    // views the memcpyable elements in place. notes, the out-of-line elements
+    // are 8-byte aligned if the buffer is, e.g., the mmaped file, while the
+    // inline ones may be anywhere, which should be copied by iterating
+    std::span<const T> span() const {
+        static_assert(_::IsTrivialSlot<T>, "Only memcpyable elements");
+        static_assert(!Inline, "The fixed array isn't aligned in the slot");
+        REFLPP_ASSERT(reinterpret_cast<std::uintptr_t>(p_) % alignof(T) == 0);
+        return {reinterpret_cast<const T*>(p_), size_};
+    }
+
+   private:
+    const char* base_{nullptr};
+    const char* p_{nullptr};
+    size_type size_{0};
+};
+
+// View is the read-only view of the struct in the flat buffer, which reads the
+// fields in place without deserializing
+template <typename T>
+class View {
+   public:
+    View() = default;
+    View(const char* base, const char* p) : base_(base), p_(p) {}
+
+    // returns the I-th field. notes, the nested struct is returned as a view,
+    // and the containers are returned as the VectorView
+    template <std::size_t I>
+    auto Get() const {
+        using F = FieldType<I, T>;
+        return _::Read<F>(base_, p_ + _::kSlotOffsets<T>[I]);
+    }
+
+    void Load(T& value) const { _::Load(base_, p_, value); }
+
+    T Load() const {
+        T value{};
+        Load(value);
+        return value;
+    }
+
+    const char* data() const { return p_; }
+
+   private:
+    const char* base_{nullptr};
+    const char* p_{nullptr};
+};
+
+// returns the view of the root struct without verification, which is only
+// for the trusted buffer
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+View<T> GetView(std::string_view data) {
+    const char* base = data.data();
+    return View<T>(base, base + _::LoadOffset(base));
+}
+
+// verifies the bounds of all offsets, which is linear in the size of the
+// reachable objects
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code Verify(std::string_view data) {
+    if (data.size() < _::kOffsetSize) {
+        return make_error(kErrorUnexpectedTerminate);
+    }
+
+    _::Verifier v{data.data(), data.size()};
+    auto root = _::LoadOffset(data.data());
+    if (v.Check(root, _::kSlotSize<T>)) {
+        v.template Verify<T>(data.data() + root);
+    }
+
+    return v.ec == kOk ? std::error_code() : make_error(v.ec);
+}
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromFlat(std::string_view data, T& value) {
+    auto ec = Verify<T>(data);
+    if (!ec) {
+        GetView<T>(data).Load(value);
+    }
+    return ec;
+}
+
+}  // namespace flat
+
+template <typename T>
+using View = flat::View<T>;
+
+}  // namespace reflpp
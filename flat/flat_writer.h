@@ -0,0 +1,215 @@
+#pragma once
+
+#include <binary/binary_writer.h>
+#include <byte_order.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+#include <utils.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// the flat layout is readable in place, which is similar to flatbuffers. each
+// value takes a fixed-size slot:
+//   - scalars are stored inline as little-endian, bool takes one byte
+//   - structs, std::array and c-style arrays are stored inline slot by slot
+//   - strings and containers take an offset to the out-of-line object, which
+//     is the element count followed by the element slots
+//   - optional and smart pointers take an offset to the out-of-line slot of
+//     the value, or zero if it's empty
+// the buffer starts with the offset of the root struct. notes, offsets are
+// relative to the beginning of the buffer, and the out-of-line objects are
+// 8-byte aligned, so that the memcpyable elements of containers can be viewed
+// as a span
+namespace reflpp {
+namespace flat {
+
+namespace _ {
+
+using Offset = std::uint64_t;
+
+inline constexpr std::size_t kOffsetSize = sizeof(Offset);
+inline constexpr std::size_t kAlignment = 8;
+
+// the object referred by the offset
+template <typename T>
+inline constexpr bool IsOutOfLine =
+    IsStringLike<T> || IsSequenceContainer<T> || IsSetContainer<T> ||
+    IsMapContainer<T> || IsOptional<T> || IsSmartPtr<T>;
+
+template <typename T, typename = void>
+struct SlotSizeImpl;
+
+template <typename T>
+inline constexpr std::size_t kSlotSize = SlotSizeImpl<RemoveCVRef<T>>::value;
+
+template <typename T>
+struct SlotSizeImpl<T, std::enable_if_t<IsBool<T>>>
+    : std::integral_constant<std::size_t, 1> {};
+
+template <typename T>
+struct SlotSizeImpl<T, std::enable_if_t<binary::_::IsScalar<T>>>
+    : std::integral_constant<std::size_t, sizeof(T)> {};
+
+template <typename T>
+struct SlotSizeImpl<T, std::enable_if_t<IsOutOfLine<T>>>
+    : std::integral_constant<std::size_t, kOffsetSize> {};
+
+template <typename T, std::size_t N>
+struct SlotSizeImpl<T[N]>
+    : std::integral_constant<std::size_t, N * kSlotSize<T>> {};
+
+template <typename T, std::size_t N>
+struct SlotSizeImpl<std::array<T, N>>
+    : std::integral_constant<std::size_t, N * kSlotSize<T>> {};
+
+template <typename K, typename V>
+struct SlotSizeImpl<std::pair<K, V>>
+    : std::integral_constant<std::size_t, kSlotSize<K> + kSlotSize<V>> {};
+
+template <typename T, std::size_t... Is>
+consteval auto GetSlotOffsetsImpl(std::index_sequence<Is...>) {
+    constexpr std::size_t N = sizeof...(Is);
+    constexpr std::array<std::size_t, N> sizes{kSlotSize<FieldType<Is, T>>...};
+
+    std::array<std::size_t, N + 1> offsets{};
+    for (std::size_t i = 0; i < N; ++i) {
+        offsets[i + 1] = offsets[i] + sizes[i];
+    }
+    return offsets;
+}
+
+// the slot offsets of fields, and the last one is the size of the struct
+template <typename T>
+inline constexpr auto kSlotOffsets =
+    GetSlotOffsetsImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+template <typename T>
+struct SlotSizeImpl<T, std::enable_if_t<IsAggregateStruct<T>>>
+    : std::integral_constant<std::size_t, kSlotOffsets<T>.back()> {};
+
+// the slot is the same as the memory representation, which is copied as is
+template <typename T>
+inline constexpr bool IsTrivialSlot =
+    binary::IsMemcpyable<T> && kSlotSize<T> == sizeof(T);
+
+// the element type of the out-of-line containers. notes, the key of the map
+// is stored without the const qualifier
+template <typename T, typename = void>
+struct ElementOf {
+    using type = typename T::value_type;
+};
+
+template <typename T>
+struct ElementOf<T, std::enable_if_t<IsMapContainer<T>>> {
+    using type = std::pair<typename T::key_type, typename T::mapped_type>;
+};
+
+template <typename T>
+using ElementType = typename ElementOf<RemoveCVRef<T>>::type;
+
+template <typename Stream>
+class Builder {
+   public:
+    explicit Builder(Stream& s) : s_(s), base_(s.size()) {}
+
+    // returns the position of the zero-filled object, which is relative to
+    // the beginning of the buffer
+    std::size_t Allocate(std::size_t n) {
+        auto pos = AlignUp(s_.size() - base_, kAlignment);
+        s_.resize(base_ + pos + n);
+        return pos;
+    }
+
+    char* At(std::size_t pos) { return s_.data() + base_ + pos; }
+
+   private:
+    Stream& s_;
+    std::size_t base_;
+};
+
+template <typename Stream, typename T>
+void PutSlot(Builder<Stream>& b, std::size_t pos, const T& v);
+
+// the out-of-line object of containers
+template <typename Stream, typename T>
+Offset PutElements(Builder<Stream>& b, const T& v) {
+    using E = ElementType<T>;
+    constexpr std::size_t slot = kSlotSize<E>;
+
+    auto pos = b.Allocate(kOffsetSize + v.size() * slot);
+    StoreLittleEndian(b.At(pos), static_cast<Offset>(v.size()));
+
+    auto elems = pos + kOffsetSize;
+    if constexpr (IsTrivialSlot<E> &&
+                  (IsStringLike<T> || IsTemplateOf<std::vector, T>)) {
+        if (!v.empty()) {
+            std::memcpy(b.At(elems), v.data(), v.size() * slot);
+        }
+    } else {
+        for (const auto& e : v) {
+            PutSlot(b, elems, e);
+            elems += slot;
+        }
+    }
+    return pos;
+}
+
+template <typename Stream, typename T>
+void PutSlot(Builder<Stream>& b, std::size_t pos, const T& v) {
+    if constexpr (IsTrivialSlot<T>) {
+        std::memcpy(b.At(pos), std::addressof(v), sizeof(T));
+    } else if constexpr (IsBool<T>) {
+        *b.At(pos) = v ? 1 : 0;
+    } else if constexpr (IsEnum<T>) {
+        PutSlot(b, pos, static_cast<std::underlying_type_t<T>>(v));
+    } else if constexpr (binary::_::IsScalar<T>) {
+        StoreLittleEndian(b.At(pos), v);
+    } else if constexpr (IsOptional<T> || IsSmartPtr<T>) {
+        if (v) {
+            auto off = b.Allocate(kSlotSize<decltype(*v)>);
+            PutSlot(b, off, *v);
+            StoreLittleEndian(b.At(pos), static_cast<Offset>(off));
+        }
+    } else if constexpr (IsOutOfLine<T>) {
+        auto off = PutElements(b, v);
+        StoreLittleEndian(b.At(pos), off);
+    } else if constexpr (IsFixedArray<T>) {
+        for (const auto& e : v) {
+            PutSlot(b, pos, e);
+            pos += kSlotSize<decltype(e)>;
+        }
+    } else if constexpr (IsPair<T>) {
+        PutSlot(b, pos, v.first);
+        PutSlot(b, pos + kSlotSize<decltype(v.first)>, v.second);
+    } else {
+        static_assert(IsAggregateStruct<T>, "Unsupported type");
+
+        ForEach(v, [&b, pos](auto idx, const auto& field) {
+            PutSlot(b, pos + kSlotOffsets<T>[idx], field);
+        });
+    }
+}
+
+}  // namespace _
+
+// appends the flat buffer of the struct to the stream, which should be
+// resizable and contiguous, e.g., std::string
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToFlat(Stream& s, const T& t) {
+    _::Builder<Stream> b(s);
+
+    auto root = b.Allocate(_::kOffsetSize);
+    auto pos = b.Allocate(_::kSlotSize<T>);
+    StoreLittleEndian(b.At(root), static_cast<_::Offset>(pos));
+    _::PutSlot(b, pos, t);
+}
+
+}  // namespace flat
+}  // namespace reflpp
@@ -7,83 +7,533 @@
 #include <tuple>
 
 #define REFLPP_FOR_EACH_CNT(MACRO) \
-    MACRO(1)                       \
-    MACRO(2)                       \
-    MACRO(3)                       \
-    MACRO(4)                       \
-    MACRO(5)                       \
-    MACRO(6)                       \
-    MACRO(7)                       \
-    MACRO(8)                       \
-    MACRO(9)                       \
-    MACRO(10)                      \
-    MACRO(11)                      \
-    MACRO(12)                      \
-    MACRO(13)                      \
-    MACRO(14)                      \
-    MACRO(15)                      \
-    MACRO(16)                      \
-    MACRO(17)                      \
-    MACRO(18)                      \
-    MACRO(19)                      \
-    MACRO(20)                      \
-    MACRO(21)                      \
-    MACRO(22)                      \
-    MACRO(23)                      \
-    MACRO(24)                      \
-    MACRO(25)                      \
-    MACRO(26)                      \
-    MACRO(27)                      \
-    MACRO(28)                      \
-    MACRO(29)                      \
-    MACRO(30)                      \
-    MACRO(31)                      \
-    MACRO(32)
-
-#define REFLPP_DECL_TIE_AS_TUPLE(N)                                          \
-    template <typename T, typename... Args>                                  \
-    constexpr auto TieAsTupleImpl(T& obj,                                    \
-                                  std::integral_constant<std::size_t, N>) {  \
-        auto& [REFLPP_UNPACK_FIELDS_##N] =                                   \
-            const_cast<std::remove_cv_t<T>&>(obj);                           \
-        return [](auto&... args) {                                           \
-            return std::make_tuple(WorkaroundWrap(std::addressof(args))...); \
-        }(REFLPP_UNPACK_FIELDS_##N);                                         \
+    MACRO(1)                   \
+    MACRO(2)                   \
+    MACRO(3)                   \
+    MACRO(4)                   \
+    MACRO(5)                   \
+    MACRO(6)                   \
+    MACRO(7)                   \
+    MACRO(8)                   \
+    MACRO(9)                   \
+    MACRO(10)                  \
+    MACRO(11)                  \
+    MACRO(12)                  \
+    MACRO(13)                  \
+    MACRO(14)                  \
+    MACRO(15)                  \
+    MACRO(16)                  \
+    MACRO(17)                  \
+    MACRO(18)                  \
+    MACRO(19)                  \
+    MACRO(20)                  \
+    MACRO(21)                  \
+    MACRO(22)                  \
+    MACRO(23)                  \
+    MACRO(24)                  \
+    MACRO(25)                  \
+    MACRO(26)                  \
+    MACRO(27)                  \
+    MACRO(28)                  \
+    MACRO(29)                  \
+    MACRO(30)                  \
+    MACRO(31)                  \
+    MACRO(32)                  \
+    MACRO(33)                  \
+    MACRO(34)                  \
+    MACRO(35)                  \
+    MACRO(36)                  \
+    MACRO(37)                  \
+    MACRO(38)                  \
+    MACRO(39)                  \
+    MACRO(40)                  \
+    MACRO(41)                  \
+    MACRO(42)                  \
+    MACRO(43)                  \
+    MACRO(44)                  \
+    MACRO(45)                  \
+    MACRO(46)                  \
+    MACRO(47)                  \
+    MACRO(48)                  \
+    MACRO(49)                  \
+    MACRO(50)                  \
+    MACRO(51)                  \
+    MACRO(52)                  \
+    MACRO(53)                  \
+    MACRO(54)                  \
+    MACRO(55)                  \
+    MACRO(56)                  \
+    MACRO(57)                  \
+    MACRO(58)                  \
+    MACRO(59)                  \
+    MACRO(60)                  \
+    MACRO(61)                  \
+    MACRO(62)                  \
+    MACRO(63)                  \
+    MACRO(64)                  \
+    MACRO(65)                  \
+    MACRO(66)                  \
+    MACRO(67)                  \
+    MACRO(68)                  \
+    MACRO(69)                  \
+    MACRO(70)                  \
+    MACRO(71)                  \
+    MACRO(72)                  \
+    MACRO(73)                  \
+    MACRO(74)                  \
+    MACRO(75)                  \
+    MACRO(76)                  \
+    MACRO(77)                  \
+    MACRO(78)                  \
+    MACRO(79)                  \
+    MACRO(80)                  \
+    MACRO(81)                  \
+    MACRO(82)                  \
+    MACRO(83)                  \
+    MACRO(84)                  \
+    MACRO(85)                  \
+    MACRO(86)                  \
+    MACRO(87)                  \
+    MACRO(88)                  \
+    MACRO(89)                  \
+    MACRO(90)                  \
+    MACRO(91)                  \
+    MACRO(92)                  \
+    MACRO(93)                  \
+    MACRO(94)                  \
+    MACRO(95)                  \
+    MACRO(96)                  \
+    MACRO(97)                  \
+    MACRO(98)                  \
+    MACRO(99)                  \
+    MACRO(100)                 \
+    MACRO(101)                 \
+    MACRO(102)                 \
+    MACRO(103)                 \
+    MACRO(104)                 \
+    MACRO(105)                 \
+    MACRO(106)                 \
+    MACRO(107)                 \
+    MACRO(108)                 \
+    MACRO(109)                 \
+    MACRO(110)                 \
+    MACRO(111)                 \
+    MACRO(112)                 \
+    MACRO(113)                 \
+    MACRO(114)                 \
+    MACRO(115)                 \
+    MACRO(116)                 \
+    MACRO(117)                 \
+    MACRO(118)                 \
+    MACRO(119)                 \
+    MACRO(120)                 \
+    MACRO(121)                 \
+    MACRO(122)                 \
+    MACRO(123)                 \
+    MACRO(124)                 \
+    MACRO(125)                 \
+    MACRO(126)                 \
+    MACRO(127)                 \
+    MACRO(128)                 \
+    MACRO(129)                 \
+    MACRO(130)                 \
+    MACRO(131)                 \
+    MACRO(132)                 \
+    MACRO(133)                 \
+    MACRO(134)                 \
+    MACRO(135)                 \
+    MACRO(136)                 \
+    MACRO(137)                 \
+    MACRO(138)                 \
+    MACRO(139)                 \
+    MACRO(140)                 \
+    MACRO(141)                 \
+    MACRO(142)                 \
+    MACRO(143)                 \
+    MACRO(144)                 \
+    MACRO(145)                 \
+    MACRO(146)                 \
+    MACRO(147)                 \
+    MACRO(148)                 \
+    MACRO(149)                 \
+    MACRO(150)                 \
+    MACRO(151)                 \
+    MACRO(152)                 \
+    MACRO(153)                 \
+    MACRO(154)                 \
+    MACRO(155)                 \
+    MACRO(156)                 \
+    MACRO(157)                 \
+    MACRO(158)                 \
+    MACRO(159)                 \
+    MACRO(160)                 \
+    MACRO(161)                 \
+    MACRO(162)                 \
+    MACRO(163)                 \
+    MACRO(164)                 \
+    MACRO(165)                 \
+    MACRO(166)                 \
+    MACRO(167)                 \
+    MACRO(168)                 \
+    MACRO(169)                 \
+    MACRO(170)                 \
+    MACRO(171)                 \
+    MACRO(172)                 \
+    MACRO(173)                 \
+    MACRO(174)                 \
+    MACRO(175)                 \
+    MACRO(176)                 \
+    MACRO(177)                 \
+    MACRO(178)                 \
+    MACRO(179)                 \
+    MACRO(180)                 \
+    MACRO(181)                 \
+    MACRO(182)                 \
+    MACRO(183)                 \
+    MACRO(184)                 \
+    MACRO(185)                 \
+    MACRO(186)                 \
+    MACRO(187)                 \
+    MACRO(188)                 \
+    MACRO(189)                 \
+    MACRO(190)                 \
+    MACRO(191)                 \
+    MACRO(192)                 \
+    MACRO(193)                 \
+    MACRO(194)                 \
+    MACRO(195)                 \
+    MACRO(196)                 \
+    MACRO(197)                 \
+    MACRO(198)                 \
+    MACRO(199)                 \
+    MACRO(200)                 \
+    MACRO(201)                 \
+    MACRO(202)                 \
+    MACRO(203)                 \
+    MACRO(204)                 \
+    MACRO(205)                 \
+    MACRO(206)                 \
+    MACRO(207)                 \
+    MACRO(208)                 \
+    MACRO(209)                 \
+    MACRO(210)                 \
+    MACRO(211)                 \
+    MACRO(212)                 \
+    MACRO(213)                 \
+    MACRO(214)                 \
+    MACRO(215)                 \
+    MACRO(216)                 \
+    MACRO(217)                 \
+    MACRO(218)                 \
+    MACRO(219)                 \
+    MACRO(220)                 \
+    MACRO(221)                 \
+    MACRO(222)                 \
+    MACRO(223)                 \
+    MACRO(224)                 \
+    MACRO(225)                 \
+    MACRO(226)                 \
+    MACRO(227)                 \
+    MACRO(228)                 \
+    MACRO(229)                 \
+    MACRO(230)                 \
+    MACRO(231)                 \
+    MACRO(232)                 \
+    MACRO(233)                 \
+    MACRO(234)                 \
+    MACRO(235)                 \
+    MACRO(236)                 \
+    MACRO(237)                 \
+    MACRO(238)                 \
+    MACRO(239)                 \
+    MACRO(240)                 \
+    MACRO(241)                 \
+    MACRO(242)                 \
+    MACRO(243)                 \
+    MACRO(244)                 \
+    MACRO(245)                 \
+    MACRO(246)                 \
+    MACRO(247)                 \
+    MACRO(248)                 \
+    MACRO(249)                 \
+    MACRO(250)                 \
+    MACRO(251)                 \
+    MACRO(252)                 \
+    MACRO(253)                 \
+    MACRO(254)                 \
+    MACRO(255)                 \
+    MACRO(256)
+
+// binds the fields once, and passes all of them to the visitor. notes, the
+// constness is dropped, and restored by the callers if needed
+#define REFLPP_DECL_VISIT_FIELDS(N)                                         \
+    template <typename T, typename F>                                       \
+    constexpr decltype(auto) VisitFieldsImpl(                               \
+        T& obj, F&& f, std::integral_constant<std::size_t, N>) {            \
+        auto& [REFLPP_UNPACK_FIELDS_##N] =                                  \
+            const_cast<std::remove_cv_t<T>&>(obj);                          \
+        return f(REFLPP_UNPACK_FIELDS_##N);                                 \
     }
 
+// notes, each list is built on the previous one, so that the header stays
+// linear in the number of fields
 // clang-format off
 #define REFLPP_UNPACK_FIELDS_1   a1
-#define REFLPP_UNPACK_FIELDS_2   a1, a2
-#define REFLPP_UNPACK_FIELDS_3   a1, a2, a3
-#define REFLPP_UNPACK_FIELDS_4   a1, a2, a3, a4
-#define REFLPP_UNPACK_FIELDS_5   a1, a2, a3, a4, a5
-#define REFLPP_UNPACK_FIELDS_6   a1, a2, a3, a4, a5, a6
-#define REFLPP_UNPACK_FIELDS_7   a1, a2, a3, a4, a5, a6, a7
-#define REFLPP_UNPACK_FIELDS_8   a1, a2, a3, a4, a5, a6, a7, a8
-#define REFLPP_UNPACK_FIELDS_9   a1, a2, a3, a4, a5, a6, a7, a8, a9
-#define REFLPP_UNPACK_FIELDS_10  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10
-#define REFLPP_UNPACK_FIELDS_11  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11
-#define REFLPP_UNPACK_FIELDS_12  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12
-#define REFLPP_UNPACK_FIELDS_13  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13
-#define REFLPP_UNPACK_FIELDS_14  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14
-#define REFLPP_UNPACK_FIELDS_15  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15
-#define REFLPP_UNPACK_FIELDS_16  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16
-#define REFLPP_UNPACK_FIELDS_17  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17
-#define REFLPP_UNPACK_FIELDS_18  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18
-#define REFLPP_UNPACK_FIELDS_19  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19
-#define REFLPP_UNPACK_FIELDS_20  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20
-#define REFLPP_UNPACK_FIELDS_21  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21
-#define REFLPP_UNPACK_FIELDS_22  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22
-#define REFLPP_UNPACK_FIELDS_23  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23
-#define REFLPP_UNPACK_FIELDS_24  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24
-#define REFLPP_UNPACK_FIELDS_25  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25
-#define REFLPP_UNPACK_FIELDS_26  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26
-#define REFLPP_UNPACK_FIELDS_27  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27
-#define REFLPP_UNPACK_FIELDS_28  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28
-#define REFLPP_UNPACK_FIELDS_29  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29
-#define REFLPP_UNPACK_FIELDS_30  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30
-#define REFLPP_UNPACK_FIELDS_31  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31
-#define REFLPP_UNPACK_FIELDS_32  a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32
+#define REFLPP_UNPACK_FIELDS_2   REFLPP_UNPACK_FIELDS_1, a2
+#define REFLPP_UNPACK_FIELDS_3   REFLPP_UNPACK_FIELDS_2, a3
+#define REFLPP_UNPACK_FIELDS_4   REFLPP_UNPACK_FIELDS_3, a4
+#define REFLPP_UNPACK_FIELDS_5   REFLPP_UNPACK_FIELDS_4, a5
+#define REFLPP_UNPACK_FIELDS_6   REFLPP_UNPACK_FIELDS_5, a6
+#define REFLPP_UNPACK_FIELDS_7   REFLPP_UNPACK_FIELDS_6, a7
+#define REFLPP_UNPACK_FIELDS_8   REFLPP_UNPACK_FIELDS_7, a8
+#define REFLPP_UNPACK_FIELDS_9   REFLPP_UNPACK_FIELDS_8, a9
+#define REFLPP_UNPACK_FIELDS_10  REFLPP_UNPACK_FIELDS_9, a10
+#define REFLPP_UNPACK_FIELDS_11  REFLPP_UNPACK_FIELDS_10, a11
+#define REFLPP_UNPACK_FIELDS_12  REFLPP_UNPACK_FIELDS_11, a12
+#define REFLPP_UNPACK_FIELDS_13  REFLPP_UNPACK_FIELDS_12, a13
+#define REFLPP_UNPACK_FIELDS_14  REFLPP_UNPACK_FIELDS_13, a14
+#define REFLPP_UNPACK_FIELDS_15  REFLPP_UNPACK_FIELDS_14, a15
+#define REFLPP_UNPACK_FIELDS_16  REFLPP_UNPACK_FIELDS_15, a16
+#define REFLPP_UNPACK_FIELDS_17  REFLPP_UNPACK_FIELDS_16, a17
+#define REFLPP_UNPACK_FIELDS_18  REFLPP_UNPACK_FIELDS_17, a18
+#define REFLPP_UNPACK_FIELDS_19  REFLPP_UNPACK_FIELDS_18, a19
+#define REFLPP_UNPACK_FIELDS_20  REFLPP_UNPACK_FIELDS_19, a20
+#define REFLPP_UNPACK_FIELDS_21  REFLPP_UNPACK_FIELDS_20, a21
+#define REFLPP_UNPACK_FIELDS_22  REFLPP_UNPACK_FIELDS_21, a22
+#define REFLPP_UNPACK_FIELDS_23  REFLPP_UNPACK_FIELDS_22, a23
+#define REFLPP_UNPACK_FIELDS_24  REFLPP_UNPACK_FIELDS_23, a24
+#define REFLPP_UNPACK_FIELDS_25  REFLPP_UNPACK_FIELDS_24, a25
+#define REFLPP_UNPACK_FIELDS_26  REFLPP_UNPACK_FIELDS_25, a26
+#define REFLPP_UNPACK_FIELDS_27  REFLPP_UNPACK_FIELDS_26, a27
+#define REFLPP_UNPACK_FIELDS_28  REFLPP_UNPACK_FIELDS_27, a28
+#define REFLPP_UNPACK_FIELDS_29  REFLPP_UNPACK_FIELDS_28, a29
+#define REFLPP_UNPACK_FIELDS_30  REFLPP_UNPACK_FIELDS_29, a30
+#define REFLPP_UNPACK_FIELDS_31  REFLPP_UNPACK_FIELDS_30, a31
+#define REFLPP_UNPACK_FIELDS_32  REFLPP_UNPACK_FIELDS_31, a32
+#define REFLPP_UNPACK_FIELDS_33  REFLPP_UNPACK_FIELDS_32, a33
+#define REFLPP_UNPACK_FIELDS_34  REFLPP_UNPACK_FIELDS_33, a34
+#define REFLPP_UNPACK_FIELDS_35  REFLPP_UNPACK_FIELDS_34, a35
+#define REFLPP_UNPACK_FIELDS_36  REFLPP_UNPACK_FIELDS_35, a36
+#define REFLPP_UNPACK_FIELDS_37  REFLPP_UNPACK_FIELDS_36, a37
+#define REFLPP_UNPACK_FIELDS_38  REFLPP_UNPACK_FIELDS_37, a38
+#define REFLPP_UNPACK_FIELDS_39  REFLPP_UNPACK_FIELDS_38, a39
+#define REFLPP_UNPACK_FIELDS_40  REFLPP_UNPACK_FIELDS_39, a40
+#define REFLPP_UNPACK_FIELDS_41  REFLPP_UNPACK_FIELDS_40, a41
+#define REFLPP_UNPACK_FIELDS_42  REFLPP_UNPACK_FIELDS_41, a42
+#define REFLPP_UNPACK_FIELDS_43  REFLPP_UNPACK_FIELDS_42, a43
+#define REFLPP_UNPACK_FIELDS_44  REFLPP_UNPACK_FIELDS_43, a44
+#define REFLPP_UNPACK_FIELDS_45  REFLPP_UNPACK_FIELDS_44, a45
+#define REFLPP_UNPACK_FIELDS_46  REFLPP_UNPACK_FIELDS_45, a46
+#define REFLPP_UNPACK_FIELDS_47  REFLPP_UNPACK_FIELDS_46, a47
+#define REFLPP_UNPACK_FIELDS_48  REFLPP_UNPACK_FIELDS_47, a48
+#define REFLPP_UNPACK_FIELDS_49  REFLPP_UNPACK_FIELDS_48, a49
+#define REFLPP_UNPACK_FIELDS_50  REFLPP_UNPACK_FIELDS_49, a50
+#define REFLPP_UNPACK_FIELDS_51  REFLPP_UNPACK_FIELDS_50, a51
+#define REFLPP_UNPACK_FIELDS_52  REFLPP_UNPACK_FIELDS_51, a52
+#define REFLPP_UNPACK_FIELDS_53  REFLPP_UNPACK_FIELDS_52, a53
+#define REFLPP_UNPACK_FIELDS_54  REFLPP_UNPACK_FIELDS_53, a54
+#define REFLPP_UNPACK_FIELDS_55  REFLPP_UNPACK_FIELDS_54, a55
+#define REFLPP_UNPACK_FIELDS_56  REFLPP_UNPACK_FIELDS_55, a56
+#define REFLPP_UNPACK_FIELDS_57  REFLPP_UNPACK_FIELDS_56, a57
+#define REFLPP_UNPACK_FIELDS_58  REFLPP_UNPACK_FIELDS_57, a58
+#define REFLPP_UNPACK_FIELDS_59  REFLPP_UNPACK_FIELDS_58, a59
+#define REFLPP_UNPACK_FIELDS_60  REFLPP_UNPACK_FIELDS_59, a60
+#define REFLPP_UNPACK_FIELDS_61  REFLPP_UNPACK_FIELDS_60, a61
+#define REFLPP_UNPACK_FIELDS_62  REFLPP_UNPACK_FIELDS_61, a62
+#define REFLPP_UNPACK_FIELDS_63  REFLPP_UNPACK_FIELDS_62, a63
+#define REFLPP_UNPACK_FIELDS_64  REFLPP_UNPACK_FIELDS_63, a64
+#define REFLPP_UNPACK_FIELDS_65  REFLPP_UNPACK_FIELDS_64, a65
+#define REFLPP_UNPACK_FIELDS_66  REFLPP_UNPACK_FIELDS_65, a66
+#define REFLPP_UNPACK_FIELDS_67  REFLPP_UNPACK_FIELDS_66, a67
+#define REFLPP_UNPACK_FIELDS_68  REFLPP_UNPACK_FIELDS_67, a68
+#define REFLPP_UNPACK_FIELDS_69  REFLPP_UNPACK_FIELDS_68, a69
+#define REFLPP_UNPACK_FIELDS_70  REFLPP_UNPACK_FIELDS_69, a70
+#define REFLPP_UNPACK_FIELDS_71  REFLPP_UNPACK_FIELDS_70, a71
+#define REFLPP_UNPACK_FIELDS_72  REFLPP_UNPACK_FIELDS_71, a72
+#define REFLPP_UNPACK_FIELDS_73  REFLPP_UNPACK_FIELDS_72, a73
+#define REFLPP_UNPACK_FIELDS_74  REFLPP_UNPACK_FIELDS_73, a74
+#define REFLPP_UNPACK_FIELDS_75  REFLPP_UNPACK_FIELDS_74, a75
+#define REFLPP_UNPACK_FIELDS_76  REFLPP_UNPACK_FIELDS_75, a76
+#define REFLPP_UNPACK_FIELDS_77  REFLPP_UNPACK_FIELDS_76, a77
+#define REFLPP_UNPACK_FIELDS_78  REFLPP_UNPACK_FIELDS_77, a78
+#define REFLPP_UNPACK_FIELDS_79  REFLPP_UNPACK_FIELDS_78, a79
+#define REFLPP_UNPACK_FIELDS_80  REFLPP_UNPACK_FIELDS_79, a80
+#define REFLPP_UNPACK_FIELDS_81  REFLPP_UNPACK_FIELDS_80, a81
+#define REFLPP_UNPACK_FIELDS_82  REFLPP_UNPACK_FIELDS_81, a82
+#define REFLPP_UNPACK_FIELDS_83  REFLPP_UNPACK_FIELDS_82, a83
+#define REFLPP_UNPACK_FIELDS_84  REFLPP_UNPACK_FIELDS_83, a84
+#define REFLPP_UNPACK_FIELDS_85  REFLPP_UNPACK_FIELDS_84, a85
+#define REFLPP_UNPACK_FIELDS_86  REFLPP_UNPACK_FIELDS_85, a86
+#define REFLPP_UNPACK_FIELDS_87  REFLPP_UNPACK_FIELDS_86, a87
+#define REFLPP_UNPACK_FIELDS_88  REFLPP_UNPACK_FIELDS_87, a88
+#define REFLPP_UNPACK_FIELDS_89  REFLPP_UNPACK_FIELDS_88, a89
+#define REFLPP_UNPACK_FIELDS_90  REFLPP_UNPACK_FIELDS_89, a90
+#define REFLPP_UNPACK_FIELDS_91  REFLPP_UNPACK_FIELDS_90, a91
+#define REFLPP_UNPACK_FIELDS_92  REFLPP_UNPACK_FIELDS_91, a92
+#define REFLPP_UNPACK_FIELDS_93  REFLPP_UNPACK_FIELDS_92, a93
+#define REFLPP_UNPACK_FIELDS_94  REFLPP_UNPACK_FIELDS_93, a94
+#define REFLPP_UNPACK_FIELDS_95  REFLPP_UNPACK_FIELDS_94, a95
+#define REFLPP_UNPACK_FIELDS_96  REFLPP_UNPACK_FIELDS_95, a96
+#define REFLPP_UNPACK_FIELDS_97  REFLPP_UNPACK_FIELDS_96, a97
+#define REFLPP_UNPACK_FIELDS_98  REFLPP_UNPACK_FIELDS_97, a98
+#define REFLPP_UNPACK_FIELDS_99  REFLPP_UNPACK_FIELDS_98, a99
+#define REFLPP_UNPACK_FIELDS_100 REFLPP_UNPACK_FIELDS_99, a100
+#define REFLPP_UNPACK_FIELDS_101 REFLPP_UNPACK_FIELDS_100, a101
+#define REFLPP_UNPACK_FIELDS_102 REFLPP_UNPACK_FIELDS_101, a102
+#define REFLPP_UNPACK_FIELDS_103 REFLPP_UNPACK_FIELDS_102, a103
+#define REFLPP_UNPACK_FIELDS_104 REFLPP_UNPACK_FIELDS_103, a104
+#define REFLPP_UNPACK_FIELDS_105 REFLPP_UNPACK_FIELDS_104, a105
+#define REFLPP_UNPACK_FIELDS_106 REFLPP_UNPACK_FIELDS_105, a106
+#define REFLPP_UNPACK_FIELDS_107 REFLPP_UNPACK_FIELDS_106, a107
+#define REFLPP_UNPACK_FIELDS_108 REFLPP_UNPACK_FIELDS_107, a108
+#define REFLPP_UNPACK_FIELDS_109 REFLPP_UNPACK_FIELDS_108, a109
+#define REFLPP_UNPACK_FIELDS_110 REFLPP_UNPACK_FIELDS_109, a110
+#define REFLPP_UNPACK_FIELDS_111 REFLPP_UNPACK_FIELDS_110, a111
+#define REFLPP_UNPACK_FIELDS_112 REFLPP_UNPACK_FIELDS_111, a112
+#define REFLPP_UNPACK_FIELDS_113 REFLPP_UNPACK_FIELDS_112, a113
+#define REFLPP_UNPACK_FIELDS_114 REFLPP_UNPACK_FIELDS_113, a114
+#define REFLPP_UNPACK_FIELDS_115 REFLPP_UNPACK_FIELDS_114, a115
+#define REFLPP_UNPACK_FIELDS_116 REFLPP_UNPACK_FIELDS_115, a116
+#define REFLPP_UNPACK_FIELDS_117 REFLPP_UNPACK_FIELDS_116, a117
+#define REFLPP_UNPACK_FIELDS_118 REFLPP_UNPACK_FIELDS_117, a118
+#define REFLPP_UNPACK_FIELDS_119 REFLPP_UNPACK_FIELDS_118, a119
+#define REFLPP_UNPACK_FIELDS_120 REFLPP_UNPACK_FIELDS_119, a120
+#define REFLPP_UNPACK_FIELDS_121 REFLPP_UNPACK_FIELDS_120, a121
+#define REFLPP_UNPACK_FIELDS_122 REFLPP_UNPACK_FIELDS_121, a122
+#define REFLPP_UNPACK_FIELDS_123 REFLPP_UNPACK_FIELDS_122, a123
+#define REFLPP_UNPACK_FIELDS_124 REFLPP_UNPACK_FIELDS_123, a124
+#define REFLPP_UNPACK_FIELDS_125 REFLPP_UNPACK_FIELDS_124, a125
+#define REFLPP_UNPACK_FIELDS_126 REFLPP_UNPACK_FIELDS_125, a126
+#define REFLPP_UNPACK_FIELDS_127 REFLPP_UNPACK_FIELDS_126, a127
+#define REFLPP_UNPACK_FIELDS_128 REFLPP_UNPACK_FIELDS_127, a128
+#define REFLPP_UNPACK_FIELDS_129 REFLPP_UNPACK_FIELDS_128, a129
+#define REFLPP_UNPACK_FIELDS_130 REFLPP_UNPACK_FIELDS_129, a130
+#define REFLPP_UNPACK_FIELDS_131 REFLPP_UNPACK_FIELDS_130, a131
+#define REFLPP_UNPACK_FIELDS_132 REFLPP_UNPACK_FIELDS_131, a132
+#define REFLPP_UNPACK_FIELDS_133 REFLPP_UNPACK_FIELDS_132, a133
+#define REFLPP_UNPACK_FIELDS_134 REFLPP_UNPACK_FIELDS_133, a134
+#define REFLPP_UNPACK_FIELDS_135 REFLPP_UNPACK_FIELDS_134, a135
+#define REFLPP_UNPACK_FIELDS_136 REFLPP_UNPACK_FIELDS_135, a136
+#define REFLPP_UNPACK_FIELDS_137 REFLPP_UNPACK_FIELDS_136, a137
+#define REFLPP_UNPACK_FIELDS_138 REFLPP_UNPACK_FIELDS_137, a138
+#define REFLPP_UNPACK_FIELDS_139 REFLPP_UNPACK_FIELDS_138, a139
+#define REFLPP_UNPACK_FIELDS_140 REFLPP_UNPACK_FIELDS_139, a140
+#define REFLPP_UNPACK_FIELDS_141 REFLPP_UNPACK_FIELDS_140, a141
+#define REFLPP_UNPACK_FIELDS_142 REFLPP_UNPACK_FIELDS_141, a142
+#define REFLPP_UNPACK_FIELDS_143 REFLPP_UNPACK_FIELDS_142, a143
+#define REFLPP_UNPACK_FIELDS_144 REFLPP_UNPACK_FIELDS_143, a144
+#define REFLPP_UNPACK_FIELDS_145 REFLPP_UNPACK_FIELDS_144, a145
+#define REFLPP_UNPACK_FIELDS_146 REFLPP_UNPACK_FIELDS_145, a146
+#define REFLPP_UNPACK_FIELDS_147 REFLPP_UNPACK_FIELDS_146, a147
+#define REFLPP_UNPACK_FIELDS_148 REFLPP_UNPACK_FIELDS_147, a148
+#define REFLPP_UNPACK_FIELDS_149 REFLPP_UNPACK_FIELDS_148, a149
+#define REFLPP_UNPACK_FIELDS_150 REFLPP_UNPACK_FIELDS_149, a150
+#define REFLPP_UNPACK_FIELDS_151 REFLPP_UNPACK_FIELDS_150, a151
+#define REFLPP_UNPACK_FIELDS_152 REFLPP_UNPACK_FIELDS_151, a152
+#define REFLPP_UNPACK_FIELDS_153 REFLPP_UNPACK_FIELDS_152, a153
+#define REFLPP_UNPACK_FIELDS_154 REFLPP_UNPACK_FIELDS_153, a154
+#define REFLPP_UNPACK_FIELDS_155 REFLPP_UNPACK_FIELDS_154, a155
+#define REFLPP_UNPACK_FIELDS_156 REFLPP_UNPACK_FIELDS_155, a156
+#define REFLPP_UNPACK_FIELDS_157 REFLPP_UNPACK_FIELDS_156, a157
+#define REFLPP_UNPACK_FIELDS_158 REFLPP_UNPACK_FIELDS_157, a158
+#define REFLPP_UNPACK_FIELDS_159 REFLPP_UNPACK_FIELDS_158, a159
+#define REFLPP_UNPACK_FIELDS_160 REFLPP_UNPACK_FIELDS_159, a160
+#define REFLPP_UNPACK_FIELDS_161 REFLPP_UNPACK_FIELDS_160, a161
+#define REFLPP_UNPACK_FIELDS_162 REFLPP_UNPACK_FIELDS_161, a162
+#define REFLPP_UNPACK_FIELDS_163 REFLPP_UNPACK_FIELDS_162, a163
+#define REFLPP_UNPACK_FIELDS_164 REFLPP_UNPACK_FIELDS_163, a164
+#define REFLPP_UNPACK_FIELDS_165 REFLPP_UNPACK_FIELDS_164, a165
+#define REFLPP_UNPACK_FIELDS_166 REFLPP_UNPACK_FIELDS_165, a166
+#define REFLPP_UNPACK_FIELDS_167 REFLPP_UNPACK_FIELDS_166, a167
+#define REFLPP_UNPACK_FIELDS_168 REFLPP_UNPACK_FIELDS_167, a168
+#define REFLPP_UNPACK_FIELDS_169 REFLPP_UNPACK_FIELDS_168, a169
+#define REFLPP_UNPACK_FIELDS_170 REFLPP_UNPACK_FIELDS_169, a170
+#define REFLPP_UNPACK_FIELDS_171 REFLPP_UNPACK_FIELDS_170, a171
+#define REFLPP_UNPACK_FIELDS_172 REFLPP_UNPACK_FIELDS_171, a172
+#define REFLPP_UNPACK_FIELDS_173 REFLPP_UNPACK_FIELDS_172, a173
+#define REFLPP_UNPACK_FIELDS_174 REFLPP_UNPACK_FIELDS_173, a174
+#define REFLPP_UNPACK_FIELDS_175 REFLPP_UNPACK_FIELDS_174, a175
+#define REFLPP_UNPACK_FIELDS_176 REFLPP_UNPACK_FIELDS_175, a176
+#define REFLPP_UNPACK_FIELDS_177 REFLPP_UNPACK_FIELDS_176, a177
+#define REFLPP_UNPACK_FIELDS_178 REFLPP_UNPACK_FIELDS_177, a178
+#define REFLPP_UNPACK_FIELDS_179 REFLPP_UNPACK_FIELDS_178, a179
+#define REFLPP_UNPACK_FIELDS_180 REFLPP_UNPACK_FIELDS_179, a180
+#define REFLPP_UNPACK_FIELDS_181 REFLPP_UNPACK_FIELDS_180, a181
+#define REFLPP_UNPACK_FIELDS_182 REFLPP_UNPACK_FIELDS_181, a182
+#define REFLPP_UNPACK_FIELDS_183 REFLPP_UNPACK_FIELDS_182, a183
+#define REFLPP_UNPACK_FIELDS_184 REFLPP_UNPACK_FIELDS_183, a184
+#define REFLPP_UNPACK_FIELDS_185 REFLPP_UNPACK_FIELDS_184, a185
+#define REFLPP_UNPACK_FIELDS_186 REFLPP_UNPACK_FIELDS_185, a186
+#define REFLPP_UNPACK_FIELDS_187 REFLPP_UNPACK_FIELDS_186, a187
+#define REFLPP_UNPACK_FIELDS_188 REFLPP_UNPACK_FIELDS_187, a188
+#define REFLPP_UNPACK_FIELDS_189 REFLPP_UNPACK_FIELDS_188, a189
+#define REFLPP_UNPACK_FIELDS_190 REFLPP_UNPACK_FIELDS_189, a190
+#define REFLPP_UNPACK_FIELDS_191 REFLPP_UNPACK_FIELDS_190, a191
+#define REFLPP_UNPACK_FIELDS_192 REFLPP_UNPACK_FIELDS_191, a192
+#define REFLPP_UNPACK_FIELDS_193 REFLPP_UNPACK_FIELDS_192, a193
+#define REFLPP_UNPACK_FIELDS_194 REFLPP_UNPACK_FIELDS_193, a194
+#define REFLPP_UNPACK_FIELDS_195 REFLPP_UNPACK_FIELDS_194, a195
+#define REFLPP_UNPACK_FIELDS_196 REFLPP_UNPACK_FIELDS_195, a196
+#define REFLPP_UNPACK_FIELDS_197 REFLPP_UNPACK_FIELDS_196, a197
+#define REFLPP_UNPACK_FIELDS_198 REFLPP_UNPACK_FIELDS_197, a198
+#define REFLPP_UNPACK_FIELDS_199 REFLPP_UNPACK_FIELDS_198, a199
+#define REFLPP_UNPACK_FIELDS_200 REFLPP_UNPACK_FIELDS_199, a200
+#define REFLPP_UNPACK_FIELDS_201 REFLPP_UNPACK_FIELDS_200, a201
+#define REFLPP_UNPACK_FIELDS_202 REFLPP_UNPACK_FIELDS_201, a202
+#define REFLPP_UNPACK_FIELDS_203 REFLPP_UNPACK_FIELDS_202, a203
+#define REFLPP_UNPACK_FIELDS_204 REFLPP_UNPACK_FIELDS_203, a204
+#define REFLPP_UNPACK_FIELDS_205 REFLPP_UNPACK_FIELDS_204, a205
+#define REFLPP_UNPACK_FIELDS_206 REFLPP_UNPACK_FIELDS_205, a206
+#define REFLPP_UNPACK_FIELDS_207 REFLPP_UNPACK_FIELDS_206, a207
+#define REFLPP_UNPACK_FIELDS_208 REFLPP_UNPACK_FIELDS_207, a208
+#define REFLPP_UNPACK_FIELDS_209 REFLPP_UNPACK_FIELDS_208, a209
+#define REFLPP_UNPACK_FIELDS_210 REFLPP_UNPACK_FIELDS_209, a210
+#define REFLPP_UNPACK_FIELDS_211 REFLPP_UNPACK_FIELDS_210, a211
+#define REFLPP_UNPACK_FIELDS_212 REFLPP_UNPACK_FIELDS_211, a212
+#define REFLPP_UNPACK_FIELDS_213 REFLPP_UNPACK_FIELDS_212, a213
+#define REFLPP_UNPACK_FIELDS_214 REFLPP_UNPACK_FIELDS_213, a214
+#define REFLPP_UNPACK_FIELDS_215 REFLPP_UNPACK_FIELDS_214, a215
+#define REFLPP_UNPACK_FIELDS_216 REFLPP_UNPACK_FIELDS_215, a216
+#define REFLPP_UNPACK_FIELDS_217 REFLPP_UNPACK_FIELDS_216, a217
+#define REFLPP_UNPACK_FIELDS_218 REFLPP_UNPACK_FIELDS_217, a218
+#define REFLPP_UNPACK_FIELDS_219 REFLPP_UNPACK_FIELDS_218, a219
+#define REFLPP_UNPACK_FIELDS_220 REFLPP_UNPACK_FIELDS_219, a220
+#define REFLPP_UNPACK_FIELDS_221 REFLPP_UNPACK_FIELDS_220, a221
+#define REFLPP_UNPACK_FIELDS_222 REFLPP_UNPACK_FIELDS_221, a222
+#define REFLPP_UNPACK_FIELDS_223 REFLPP_UNPACK_FIELDS_222, a223
+#define REFLPP_UNPACK_FIELDS_224 REFLPP_UNPACK_FIELDS_223, a224
+#define REFLPP_UNPACK_FIELDS_225 REFLPP_UNPACK_FIELDS_224, a225
+#define REFLPP_UNPACK_FIELDS_226 REFLPP_UNPACK_FIELDS_225, a226
+#define REFLPP_UNPACK_FIELDS_227 REFLPP_UNPACK_FIELDS_226, a227
+#define REFLPP_UNPACK_FIELDS_228 REFLPP_UNPACK_FIELDS_227, a228
+#define REFLPP_UNPACK_FIELDS_229 REFLPP_UNPACK_FIELDS_228, a229
+#define REFLPP_UNPACK_FIELDS_230 REFLPP_UNPACK_FIELDS_229, a230
+#define REFLPP_UNPACK_FIELDS_231 REFLPP_UNPACK_FIELDS_230, a231
+#define REFLPP_UNPACK_FIELDS_232 REFLPP_UNPACK_FIELDS_231, a232
+#define REFLPP_UNPACK_FIELDS_233 REFLPP_UNPACK_FIELDS_232, a233
+#define REFLPP_UNPACK_FIELDS_234 REFLPP_UNPACK_FIELDS_233, a234
+#define REFLPP_UNPACK_FIELDS_235 REFLPP_UNPACK_FIELDS_234, a235
+#define REFLPP_UNPACK_FIELDS_236 REFLPP_UNPACK_FIELDS_235, a236
+#define REFLPP_UNPACK_FIELDS_237 REFLPP_UNPACK_FIELDS_236, a237
+#define REFLPP_UNPACK_FIELDS_238 REFLPP_UNPACK_FIELDS_237, a238
+#define REFLPP_UNPACK_FIELDS_239 REFLPP_UNPACK_FIELDS_238, a239
+#define REFLPP_UNPACK_FIELDS_240 REFLPP_UNPACK_FIELDS_239, a240
+#define REFLPP_UNPACK_FIELDS_241 REFLPP_UNPACK_FIELDS_240, a241
+#define REFLPP_UNPACK_FIELDS_242 REFLPP_UNPACK_FIELDS_241, a242
+#define REFLPP_UNPACK_FIELDS_243 REFLPP_UNPACK_FIELDS_242, a243
+#define REFLPP_UNPACK_FIELDS_244 REFLPP_UNPACK_FIELDS_243, a244
+#define REFLPP_UNPACK_FIELDS_245 REFLPP_UNPACK_FIELDS_244, a245
+#define REFLPP_UNPACK_FIELDS_246 REFLPP_UNPACK_FIELDS_245, a246
+#define REFLPP_UNPACK_FIELDS_247 REFLPP_UNPACK_FIELDS_246, a247
+#define REFLPP_UNPACK_FIELDS_248 REFLPP_UNPACK_FIELDS_247, a248
+#define REFLPP_UNPACK_FIELDS_249 REFLPP_UNPACK_FIELDS_248, a249
+#define REFLPP_UNPACK_FIELDS_250 REFLPP_UNPACK_FIELDS_249, a250
+#define REFLPP_UNPACK_FIELDS_251 REFLPP_UNPACK_FIELDS_250, a251
+#define REFLPP_UNPACK_FIELDS_252 REFLPP_UNPACK_FIELDS_251, a252
+#define REFLPP_UNPACK_FIELDS_253 REFLPP_UNPACK_FIELDS_252, a253
+#define REFLPP_UNPACK_FIELDS_254 REFLPP_UNPACK_FIELDS_253, a254
+#define REFLPP_UNPACK_FIELDS_255 REFLPP_UNPACK_FIELDS_254, a255
+#define REFLPP_UNPACK_FIELDS_256 REFLPP_UNPACK_FIELDS_255, a256
 // clang-format on
 
 namespace reflpp {
@@ -99,36 +549,101 @@ constexpr auto WorkaroundWrap(const T& arg) noexcept {
     return Wrapper<T>{arg};
 }
 
-REFLPP_FOR_EACH_CNT(REFLPP_DECL_TIE_AS_TUPLE);
+REFLPP_FOR_EACH_CNT(REFLPP_DECL_VISIT_FIELDS);
 
 // speficication to support empty struct
-template <typename T>
-constexpr auto TieAsTupleImpl(T&, std::integral_constant<std::size_t, 0>) {
-    return std::tuple<>();
+template <typename T, typename F>
+constexpr decltype(auto) VisitFieldsImpl(
+    T&, F&& f, std::integral_constant<std::size_t, 0>) {
+    return f();
+}
+
+template <typename T, typename F, std::size_t N = FieldsCount<T>()>
+constexpr decltype(auto) VisitFields(T& obj, F&& f) {
+    static_assert(N <= 256, "At most 256 fields are supported");
+    return VisitFieldsImpl(obj, f, std::integral_constant<std::size_t, N>{});
 }
 
+// the I-th element of the pack is found by the overload resolution over the
+// flat bases, rather than the recursive std::tuple, which is quadratic in
+// the compile time and memory for the wide structs
+template <std::size_t I, typename T>
+struct Indexed {
+    T* ptr;
+};
+
+template <typename Is, typename... Ts>
+struct IndexedPack;
+
+template <std::size_t... Is, typename... Ts>
+struct IndexedPack<std::index_sequence<Is...>, Ts...> : Indexed<Is, Ts>... {};
+
+template <std::size_t I, typename T>
+constexpr T* Pick(const Indexed<I, T>& indexed) {
+    return indexed.ptr;
+}
+
+// notes, it's a named type rather than a lambda, so that the fields of the
+// same struct are bound only once for all of indexes
+struct MakePack {
+    template <typename... Ts>
+    constexpr auto operator()(Ts&... args) const {
+        using Pack = IndexedPack<std::index_sequence_for<Ts...>, Ts...>;
+        return Pack{{std::addressof(args)}...};
+    }
+};
+
+// the pointers to the fields
 template <typename T, std::size_t N = FieldsCount<T>()>
-constexpr auto TieAsTuple(T& obj) {
-    return TieAsTupleImpl(obj, std::integral_constant<std::size_t, N>{});
+constexpr auto TieFields(T& obj) {
+    return VisitFields<T, MakePack, N>(obj, MakePack{});
 }
 
-template <typename T, typename F, std::size_t... Is>
-constexpr void ForEachImpl(T& obj, F&& func, std::index_sequence<Is...>) {
-    // auto t = TieAsTuple(obj);
-    (func(Is, *(std::get<Is>(TieAsTuple(obj))).value), ...);
+// notes, the index is passed as std::integral_constant, so that the callback
+// is able to branch on it at compile time, and it's still converted to
+// std::size_t implicitly
+template <typename F, std::size_t... Is, typename... Ts>
+constexpr void ForEachFields(F& func, std::index_sequence<Is...>,
+                             Ts&... fields) {
+    (func(std::integral_constant<std::size_t, Is>{}, fields), ...);
+}
+
+template <typename T, typename F>
+constexpr void ForEachImpl(T& obj, F&& func) {
+    VisitFields(obj, [&func](auto&... fields) {
+        ForEachFields(func, std::index_sequence_for<decltype(fields)...>{},
+                      fields...);
+    });
 }
 
 template <typename T, typename F, std::size_t... Is>
 constexpr void ForEachTupleImpl(T& obj, F&& func, std::index_sequence<Is...>) {
-    (func(Is, std::get<Is>(obj)), ...);
+    (func(std::integral_constant<std::size_t, Is>{}, std::get<Is>(obj)), ...);
 }
 
 }  // namespace _
 
+// returns the reference to the I-th field, the constness follows the object
+template <std::size_t I, typename T>
+constexpr auto& GetField(T& obj) {
+    static_assert(I < FieldsCount<std::remove_cv_t<T>>(), "Index out of range");
+
+    auto& field = *_::Pick<I>(_::TieFields(obj));
+    if constexpr (std::is_const_v<T>) {
+        return std::as_const(field);
+    } else {
+        return field;
+    }
+}
+
+// the declared type of the I-th field
+template <std::size_t I, typename T>
+using FieldType =
+    std::remove_reference_t<decltype(GetField<I>(std::declval<T&>()))>;
+
 template <typename T, typename F, std::enable_if_t<!IsTuple<T>, int> _ = 0>
 constexpr void ForEach(const T& obj, F&& f) {
-    constexpr std::size_t N = FieldsCount<T>();
-    _::ForEachImpl(obj, std::forward<F>(f), std::make_index_sequence<N>{});
+    _::ForEachImpl(obj, std::forward<F>(f));
 }
 
 template <typename T, typename F, std::enable_if_t<IsTuple<T>, int> _ = 0>
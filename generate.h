@@ -0,0 +1,309 @@
+#pragma once
+
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// the random values of the reflectable types, e.g., the corpora for the
+// benchmarks and the fuzzing of codecs:
+//   std::mt19937_64 rng(seed);
+//   auto obj = reflpp::Generate<Foo>(rng, {.max_string_size = 64});
+// notes, the values only depend on the raw outputs of the engine, rather than
+// the std distributions whose algorithms are implementation-defined, so that
+// they are deterministic for the seed across the standard libraries
+namespace reflpp {
+
+struct GenerateOptions {
+    // the number of code points of strings
+    std::size_t min_string_size{0};
+    std::size_t max_string_size{16};
+
+    // the number of elements of containers, notes, the keys of the maps and
+    // sets may be duplicated, so that they may have less elements
+    std::size_t min_container_size{0};
+    std::size_t max_container_size{8};
+
+    // the ratio of non-ascii code points in strings
+    double unicode_ratio{0.0};
+
+    // the probability that the optionals and smart pointers have values
+    double optional_ratio{0.5};
+
+    // the containers are empty and the optionals are null below the depth,
+    // which bounds the recursive types
+    std::size_t max_depth{8};
+};
+
+namespace _ {
+
+// the ranges of code points, i.e., latin-1, greek, cyrillic, cjk and emoji
+inline constexpr std::pair<char32_t, char32_t> kUnicodeRanges[] = {
+    {0x00C0, 0x00FF}, {0x0391, 0x03C9}, {0x0410, 0x044F},
+    {0x4E00, 0x9FA5}, {0x1F600, 0x1F64F},
+};
+
+inline constexpr std::string_view kAsciiChars =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 _-.";
+
+template <typename Rng>
+class Generator {
+   public:
+    Generator(Rng& rng, const GenerateOptions& opts) : rng_(rng), opts_(opts) {}
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+   public:
+    // the 64 random bits, which concatenate the outputs of the narrow engine
+    std::uint64_t Next() {
+        using R = typename Rng::result_type;
+        constexpr std::uint64_t kRange =
+            static_cast<std::uint64_t>(Rng::max() - Rng::min());
+
+        if constexpr (kRange == std::numeric_limits<std::uint64_t>::max()) {
+            return static_cast<std::uint64_t>(R(rng_() - Rng::min()));
+        } else {
+            std::uint64_t v = 0;
+            for (std::uint64_t covered = 1; covered != 0;) {
+                v = v * (kRange + 1) + static_cast<std::uint64_t>(
+                                           R(rng_() - Rng::min()));
+                // stops once the covered range overflows 64 bits
+                covered = covered > std::numeric_limits<std::uint64_t>::max() /
+                                        (kRange + 1)
+                              ? 0
+                              : covered * (kRange + 1);
+            }
+            return v;
+        }
+    }
+
+    // returns the value in [0, n) by the multiply-shift
+    std::uint64_t Uniform(std::uint64_t n) {
+        auto r = static_cast<unsigned __int128>(Next()) * n;
+        return static_cast<std::uint64_t>(r >> 64);
+    }
+
+    // returns the value in [lo, hi]
+    std::size_t Between(std::size_t lo, std::size_t hi) {
+        return hi > lo ? lo + Uniform(hi - lo + 1) : lo;
+    }
+
+    // returns the value in [0, 1)
+    double Unit() { return static_cast<double>(Next() >> 11) * 0x1p-53; }
+
+    bool Chance(double p) { return Unit() < p; }
+
+    std::size_t ContainerSize() {
+        return depth_ < opts_.max_depth
+                   ? Between(opts_.min_container_size, opts_.max_container_size)
+                   : 0;
+    }
+
+    bool HasValue() {
+        return depth_ < opts_.max_depth && Chance(opts_.optional_ratio);
+    }
+
+    template <typename T>
+    void Fill(T& value);
+
+   private:
+    template <typename T>
+    T Make() {
+        T value{};
+        Fill(value);
+        return value;
+    }
+
+    template <typename T>
+    void FillInt(T& value) {
+        // notes, the small values are more common in practice
+        if (Chance(0.75)) {
+            value = static_cast<T>(Uniform(1000));
+            if constexpr (std::is_signed_v<T>) {
+                if (Chance(0.25)) value = static_cast<T>(-value);
+            }
+        } else {
+            value = static_cast<T>(Next());
+        }
+    }
+
+    template <typename T>
+    void FillString(T& value) {
+        using C = typename T::value_type;
+
+        value.clear();
+        const std::size_t n =
+            Between(opts_.min_string_size, opts_.max_string_size);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (opts_.unicode_ratio > 0 && Chance(opts_.unicode_ratio)) {
+                const auto& [lo, hi] =
+                    kUnicodeRanges[Uniform(std::size(kUnicodeRanges))];
+                AppendCodePoint(value, lo + Uniform(hi - lo + 1));
+            } else {
+                value.push_back(
+                    static_cast<C>(kAsciiChars[Uniform(kAsciiChars.size())]));
+            }
+        }
+    }
+
+    // notes, the code points are encoded in utf-8 for the strings of char
+    template <typename T>
+    static void AppendCodePoint(T& s, char32_t cp) {
+        using C = typename T::value_type;
+        if constexpr (sizeof(C) == 1) {
+            if (cp < 0x800) {
+                s.push_back(static_cast<C>(0xC0 | (cp >> 6)));
+            } else if (cp < 0x10000) {
+                s.push_back(static_cast<C>(0xE0 | (cp >> 12)));
+                s.push_back(static_cast<C>(0x80 | ((cp >> 6) & 0x3F)));
+            } else {
+                s.push_back(static_cast<C>(0xF0 | (cp >> 18)));
+                s.push_back(static_cast<C>(0x80 | ((cp >> 12) & 0x3F)));
+                s.push_back(static_cast<C>(0x80 | ((cp >> 6) & 0x3F)));
+            }
+            s.push_back(static_cast<C>(0x80 | (cp & 0x3F)));
+        } else if constexpr (sizeof(C) == 2) {
+            if (cp >= 0x10000) {
+                cp -= 0x10000;
+                s.push_back(static_cast<C>(0xD800 | (cp >> 10)));
+                cp = 0xDC00 | (cp & 0x3FF);
+            }
+            s.push_back(static_cast<C>(cp));
+        } else {
+            s.push_back(static_cast<C>(cp));
+        }
+    }
+
+    template <typename T, std::size_t... Is>
+    void FillVariant(T& value, std::index_sequence<Is...>) {
+        const std::size_t idx = Uniform(sizeof...(Is));
+        ((idx == Is ? Fill(value.template emplace<Is>()) : void()), ...);
+    }
+
+    template <typename T, std::size_t... Is>
+    void FillTuple(T& value, std::index_sequence<Is...>) {
+        (Fill(std::get<Is>(value)), ...);
+    }
+
+   private:
+    Rng& rng_;
+    const GenerateOptions& opts_;
+
+    std::size_t depth_{0};
+};
+
+template <typename Rng>
+template <typename T>
+void Generator<Rng>::Fill(T& value) {
+    if constexpr (IsBool<T>) {
+        value = Chance(0.5);
+    } else if constexpr (IsChar<T> || std::is_same_v<T, char8_t>) {
+        value = static_cast<T>(kAsciiChars[Uniform(kAsciiChars.size())]);
+    } else if constexpr (IsIntegral<T>) {
+        FillInt(value);
+    } else if constexpr (IsFloat<T>) {
+        // the magnitudes from 1 to 1e6
+        constexpr double kScales[] = {1, 10, 100, 1e3, 1e4, 1e5, 1e6};
+        value = static_cast<T>((2 * Unit() - 1) *
+                               kScales[Uniform(std::size(kScales))]);
+    } else if constexpr (IsEnum<T>) {
+        // notes, the enumerators are unknown, so that the small values
+        value = static_cast<T>(Uniform(8));
+    } else if constexpr (IsString<T>) {
+        FillString(value);
+    } else if constexpr (IsStringView<T>) {
+        // notes, the view doesn't own the chars
+        value = {};
+    } else if constexpr (IsOptional<T>) {
+        value.reset();
+        if (HasValue()) {
+            ++depth_;
+            Fill(value.emplace());
+            --depth_;
+        }
+    } else if constexpr (IsSmartPtr<T>) {
+        using E = typename T::element_type;
+        value.reset();
+        if (HasValue()) {
+            ++depth_;
+            value = T(new E{});
+            Fill(*value);
+            --depth_;
+        }
+    } else if constexpr (IsVariant<T>) {
+        FillVariant(value, std::make_index_sequence<std::variant_size_v<T>>{});
+    } else if constexpr (IsPair<T>) {
+        Fill(value.first);
+        Fill(value.second);
+    } else if constexpr (IsTuple<T>) {
+        FillTuple(value, std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else if constexpr (IsFixedArray<T>) {
+        for (auto& e : value) {
+            Fill(e);
+        }
+    } else if constexpr (IsMapContainer<T>) {
+        using K = typename T::key_type;
+        using V = typename T::mapped_type;
+
+        value.clear();
+        const std::size_t n = ContainerSize();
+        ++depth_;
+        for (std::size_t i = 0; i < n; ++i) {
+            K key = Make<K>();
+            V v = Make<V>();
+            value.emplace(std::move(key), std::move(v));
+        }
+        --depth_;
+    } else if constexpr (IsSetContainer<T>) {
+        value.clear();
+        const std::size_t n = ContainerSize();
+        ++depth_;
+        for (std::size_t i = 0; i < n; ++i) {
+            value.insert(Make<typename T::value_type>());
+        }
+        --depth_;
+    } else if constexpr (IsSequenceContainer<T>) {
+        value.clear();
+        const std::size_t n = ContainerSize();
+        ++depth_;
+        for (std::size_t i = 0; i < n; ++i) {
+            Fill(value.emplace_back());
+        }
+        --depth_;
+    } else if constexpr (IsAggregateStruct<T>) {
+        VisitFields(value, [this](auto&... fields) { (Fill(fields), ...); });
+    } else {
+        static_assert(!sizeof(T), "Unsupported type");
+    }
+}
+
+}  // namespace _
+
+// fills the value with the random data, e.g., reusing the allocated memory
+template <typename T, typename Rng>
+void GenerateInto(Rng& rng, T& value, const GenerateOptions& opts = {}) {
+    _::Generator<Rng> g(rng, opts);
+    g.Fill(value);
+}
+
+// returns the random value, which is the same for the same state of engine
+template <typename T, typename Rng>
+T Generate(Rng& rng, const GenerateOptions& opts = {}) {
+    T value{};
+    GenerateInto(rng, value, opts);
+    return value;
+}
+
+}  // namespace reflpp
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <byte_order.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// the structural hash, which is consistent with the field-wise equality:
+//   - the types without padding and floats, i.e., whose values are equal if
+//     and only if their bytes are equal, are hashed as raw bytes in one pass,
+//     including the aggregate structs and the contiguous containers of them
+//   - the aggregate structs are hashed field by field, and the containers
+//     element by element, and the unordered containers regardless of order
+//   - the floats are hashed by bits, except that -0.0 is hashed as 0.0
+//   - the smart pointers are hashed by the pointees, if any
+//   - the rest are hashed by std::hash
+// notes, the hash values are not portable, which depend on the byte order
+namespace reflpp {
+namespace _ {
+
+inline constexpr std::uint64_t kHashP0 = 0xa0761d6478bd642full;
+inline constexpr std::uint64_t kHashP1 = 0xe7037ed1a0b428dbull;
+inline constexpr std::uint64_t kHashP2 = 0x8ebc6af09c88c6e3ull;
+inline constexpr std::uint64_t kHashP3 = 0x589965cc75374cc3ull;
+
+// the 64x64->128 multiplication folded to 64 bits
+inline std::uint64_t Mum(std::uint64_t a, std::uint64_t b) {
+    auto r = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+}
+
+inline std::uint64_t Load64(const std::uint8_t* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t Load32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// the hash of bytes in the style of wyhash, which consumes 48 bytes per
+// round with three independent lanes
+inline std::uint64_t FastHash(const void* data, std::size_t n,
+                              std::uint64_t seed) {
+    auto* p = static_cast<const std::uint8_t*>(data);
+    seed ^= Mum(seed ^ kHashP0, kHashP1);
+
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (n <= 16) {
+        if (n >= 4) {
+            const std::size_t mid = (n >> 3) << 2;
+            a = (Load32(p) << 32) | Load32(p + mid);
+            b = (Load32(p + n - 4) << 32) | Load32(p + n - 4 - mid);
+        } else if (n > 0) {
+            a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[n >> 1]) << 8) |
+                p[n - 1];
+        }
+    } else {
+        std::size_t i = n;
+        if (i > 48) {
+            std::uint64_t s1 = seed;
+            std::uint64_t s2 = seed;
+            do {
+                seed = Mum(Load64(p) ^ kHashP1, Load64(p + 8) ^ seed);
+                s1 = Mum(Load64(p + 16) ^ kHashP2, Load64(p + 24) ^ s1);
+                s2 = Mum(Load64(p + 32) ^ kHashP3, Load64(p + 40) ^ s2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= s1 ^ s2;
+        }
+        while (i > 16) {
+            seed = Mum(Load64(p) ^ kHashP1, Load64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = Load64(p + i - 16);
+        b = Load64(p + i - 8);
+    }
+
+    return Mum(kHashP1 ^ n, Mum(a ^ kHashP1, b ^ seed) ^ kHashP0);
+}
+
+inline std::uint64_t MixInt(std::uint64_t seed, std::uint64_t v) {
+    return Mum(seed ^ kHashP0, v ^ kHashP1);
+}
+
+// whether the values are equal if and only if their bytes are equal
+template <typename T>
+inline constexpr bool IsBytewiseHashable =
+    std::has_unique_object_representations_v<T>;
+
+template <typename T, typename = void>
+struct HasStdHashImpl : std::false_type {};
+
+template <typename T>
+struct HasStdHashImpl<
+    T, std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>>
+    : std::true_type {};
+
+template <typename T>
+std::uint64_t HashValue(std::uint64_t seed, const T& v);
+
+template <typename T, std::size_t... Is>
+std::uint64_t HashTuple(std::uint64_t seed, const T& v,
+                        std::index_sequence<Is...>) {
+    ((seed = HashValue(seed, std::get<Is>(v))), ...);
+    return seed;
+}
+
+template <typename T>
+std::uint64_t HashValue(std::uint64_t seed, const T& v) {
+    if constexpr (IsBytewiseHashable<T>) {
+        if constexpr (sizeof(T) <= sizeof(std::uint64_t)) {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, std::addressof(v), sizeof(T));
+            return MixInt(seed, bits);
+        } else {
+            return FastHash(std::addressof(v), sizeof(T), seed);
+        }
+    } else if constexpr (IsFloat<T>) {
+        // notes, -0.0 equals to 0.0, but their bits are different
+        using U = ::reflpp::UnsignedOfSize<T>;
+        return MixInt(seed, std::bit_cast<U>(v == 0 ? T(0) : v));
+    } else if constexpr (IsString<T> || IsStringView<T>) {
+        return FastHash(v.data(), v.size(), seed);
+    } else if constexpr (IsOptional<T>) {
+        return v ? HashValue(MixInt(seed, 1), *v) : MixInt(seed, 0);
+    } else if constexpr (IsVariant<T>) {
+        seed = MixInt(seed, v.index());
+        return std::visit(
+            [seed](const auto& alt) { return HashValue(seed, alt); }, v);
+    } else if constexpr (IsPair<T>) {
+        return HashValue(HashValue(seed, v.first), v.second);
+    } else if constexpr (IsTuple<T>) {
+        return HashTuple(seed, v,
+                         std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else if constexpr (IsSmartPtr<T>) {
+        return v ? HashValue(MixInt(seed, 1), *v) : MixInt(seed, 0);
+    } else if constexpr (IsUnorderedContainer<T>) {
+        // the sum of the element hashes is independent of the order
+        std::uint64_t sum = 0;
+        for (const typename T::value_type& e : v) {
+            sum += HashValue(seed, e);
+        }
+        return MixInt(MixInt(seed, v.size()), sum);
+    } else if constexpr (IsContainer<T>) {
+        using E = typename T::value_type;
+        if constexpr (IsContiguousContainer<T> && IsBytewiseHashable<E>) {
+            return FastHash(v.data(), v.size() * sizeof(E), seed);
+        } else {
+            seed = MixInt(seed, v.size());
+            for (const E& e : v) {
+                seed = HashValue(seed, e);
+            }
+            return seed;
+        }
+    } else if constexpr (IsAggregateStruct<T>) {
+        ForEach(v, [&seed](auto, const auto& field) {
+            seed = HashValue(seed, field);
+        });
+        return seed;
+    } else {
+        static_assert(HasStdHashImpl<T>::value, "Unsupported type");
+        return MixInt(seed, std::hash<T>{}(v));
+    }
+}
+
+}  // namespace _
+
+// returns the structural hash of the value
+template <typename T>
+std::uint64_t HashOf(const T& v, std::uint64_t seed = 0) {
+    return _::HashValue(seed, v);
+}
+
+// the hasher for the unordered containers, e.g.,
+//   std::unordered_map<Key, Value, reflpp::Hash<Key>>
+template <typename T>
+struct Hash {
+    std::size_t operator()(const T& v) const noexcept {
+        return static_cast<std::size_t>(HashOf(v));
+    }
+};
+
+}  // namespace reflpp
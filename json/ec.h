@@ -8,7 +8,8 @@
     __(kErrorParseFailure, "Parse failure")               \
     __(kErrorMismatchType, "Mismatch type")               \
     __(kErrorArrayOutOfRange, "Array out of range")       \
-    __(kErrorInvalidUtf8Char, "Invalid utf8 char")
+    __(kErrorInvalidUtf8Char, "Invalid utf8 char")        \
+    __(kErrorBufferTooSmall, "Buffer too small")
 
 namespace reflpp {
 namespace json {
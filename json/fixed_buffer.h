@@ -0,0 +1,100 @@
+#pragma once
+
+#include <json/ec.h>
+#include <json/json_writer.h>
+#include <json/pretty_formatter.h>
+#include <type_trait.h>
+
+#include <cstring>
+#include <span>
+#include <system_error>
+
+namespace reflpp {
+namespace json {
+namespace _ {
+
+// FixedBuffer is a stream over the caller-provided memory, which never
+// allocates. once the output exceeds the capacity, the following writes are
+// only counted, so that the caller knows how many bytes are required
+class FixedBuffer {
+   public:
+    using value_type = char;
+    using size_type = std::size_t;
+
+    // notes, there is no default storage, see Formatter::Fork
+    FixedBuffer() = delete;
+    explicit FixedBuffer(std::span<char> buf) : buf_(buf) {}
+
+    FixedBuffer(FixedBuffer&&) = default;
+    FixedBuffer(const FixedBuffer&) = delete;
+    FixedBuffer& operator=(FixedBuffer&&) = default;
+    FixedBuffer& operator=(const FixedBuffer&) = delete;
+
+   public:
+    // notes, the capacity is fixed
+    void reserve(size_type) {}
+
+    void append(size_type count, value_type ch) {
+        if (Fits(count)) {
+            std::memset(buf_.data() + size_, ch, count);
+        }
+        size_ += count;
+    }
+
+    void append(const value_type* s) { append(s, std::strlen(s)); }
+
+    void append(const value_type* s, size_type count) {
+        if (Fits(count)) {
+            std::memcpy(buf_.data() + size_, s, count);
+        }
+        size_ += count;
+    }
+
+    void push_back(value_type c) {
+        if (Fits(1)) {
+            buf_[size_] = c;
+        }
+        ++size_;
+    }
+
+    // notes, the data is complete only if the buffer does not overflow
+    const value_type* data() const { return buf_.data(); }
+
+    // the bytes of the whole output, which may exceed the capacity
+    size_type size() const { return size_; }
+    size_type capacity() const { return buf_.size(); }
+    bool overflow() const { return size_ > buf_.size(); }
+
+   private:
+    // notes, the size is compared before the subtraction, since it keeps
+    // growing after the overflow, and the sum could wrap around
+    bool Fits(size_type count) const {
+        return size_ <= buf_.size() && count <= buf_.size() - size_;
+    }
+
+    std::span<char> buf_;
+    size_type size_{0};
+};
+
+}  // namespace _
+
+using FixedJsonFormatter = _::Formatter<_::FixedBuffer, false, 4>;
+
+// ToJson writes the compact json into the caller-provided buffer without any
+// allocation. on success, the `size` is the bytes written. if the buffer is too
+// small, kErrorBufferTooSmall is returned and the `size` is the bytes required
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code ToJson(std::span<char> out, const T& t,
+                       std::size_t* size = nullptr) {
+    FixedJsonFormatter s(std::in_place, out);
+    FormatJsonValue(s, t);
+
+    if (size) {
+        *size = s.size();
+    }
+
+    return s.overflow() ? make_error(kErrorBufferTooSmall) : std::error_code{};
+}
+
+}  // namespace json
+}  // namespace reflpp
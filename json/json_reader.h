@@ -3,14 +3,17 @@
 #include <field_name.h>
 #include <fmt/core.h>
 #include <fmt/format.h>
+#include <for_each.h>
 #include <json/ec.h>
 #include <json/utf8.h>
 #include <type_trait.h>
 #include <utils.h>
 
+#include <array>
 #include <charconv>
 #include <iostream>
 #include <system_error>
+#include <utility>
 
 #define JSON_TOKEN_LIST(__) \
     __(kTColon, ":")        \
@@ -128,6 +131,25 @@ struct Lexer {
     std::string_view data_;
 };
 
+template <typename T>
+using FieldParser = void (*)(Lexer&, T&);
+
+template <std::size_t I, typename T>
+void ParseFieldAt(Lexer& lex, T& value) {
+    ParseItem(lex, GetField<I>(value));
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldParsersImpl(std::index_sequence<Is...>) {
+    return std::array<FieldParser<T>, sizeof...(Is)>{&ParseFieldAt<Is, T>...};
+}
+
+// the parsers of fields, which are indexed by the field index, so that the
+// field is parsed without visiting the others
+template <typename T>
+inline constexpr auto kFieldParsers =
+    GetFieldParsersImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
 template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
 void ParseItem(Lexer& lex, T& value) {
     auto field_names = ::reflpp::kFieldNames<T>;
@@ -162,10 +184,7 @@ void ParseItem(Lexer& lex, T& value) {
         // for compatibility, here ignore unknown fields in json
         // FIXME: optimize the performance
         if (auto itr = mapping.find(key); itr != mapping.end()) {
-            ForEach(value, [&itr, &lex](auto idx, auto& v) {
-                if (itr->second != idx) return;
-                ParseItem(lex, v);
-            });
+            kFieldParsers<T>[itr->second](lex, value);
         }
         started = true;
     }
@@ -15,21 +15,17 @@ namespace _ {
 // the type object and array in json allow that elements have different type
 template <typename Stream>
 inline void FormatJsonObject(Stream& s, const Directory& dict) {
-    s.push_back('{');
-    Join(s, dict.cbegin(), dict.cend(), ',', [&s](const auto& jsv) constexpr {
+    JoinObject(s, dict.cbegin(), dict.cend(), [&s](const auto& jsv) constexpr {
         FormatJsonKey(s, jsv.first);
-        s.push_back(':');
+        s.NameSeparator();
         ToJson(s, jsv.second);
     });
-    s.push_back('}');
 }
 
 template <typename Stream>
 inline void FormatJsonArray(Stream& s, const List& list) {
-    s.push_back('[');
-    Join(s, list.cbegin(), list.cend(), ',',
-         [&s](const auto& jsv) constexpr { ToJson(s, jsv); });
-    s.push_back(']');
+    JoinArray(s, list.cbegin(), list.cend(),
+              [&s](const auto& jsv) constexpr { ToJson(s, jsv); });
 }
 
 template <typename T, std::enable_if_t<IsValue<T>, int> = 0>
@@ -16,17 +16,41 @@ namespace json {
 
 namespace _ {
 
-template <typename Stream, typename It, typename T, typename F>
-inline void Join(Stream& ss, It first, It last, const T& delim, const F& f) {
+template <typename Stream, typename It, typename F>
+inline void Join(Stream& ss, It first, It last, const F& f) {
     if (first == last) return;
 
     f(*first++);
     while (first != last) {
-        ss.push_back(delim);
+        ss.ValueSeparator();
         f(*first++);
     }
 }
 
+template <typename Stream, typename It, typename F>
+inline void JoinArray(Stream& ss, It first, It last, const F& f) {
+    if (first == last) {
+        ss.EmptyArray();
+        return;
+    }
+
+    ss.BeginArray();
+    Join(ss, first, last, f);
+    ss.EndArray();
+}
+
+template <typename Stream, typename It, typename F>
+inline void JoinObject(Stream& ss, It first, It last, const F& f) {
+    if (first == last) {
+        ss.EmptyObject();
+        return;
+    }
+
+    ss.BeginObject();
+    Join(ss, first, last, f);
+    ss.EndObject();
+}
+
 }  // namespace _
 
 template <typename Stream, typename T>
@@ -40,6 +64,17 @@ template <typename Stream, typename T,
           std::enable_if_t<IsSequenceContainer<T>, int> = 0>
 inline void FormatJsonValue(Stream& ss, const T&);
 
+template <typename Stream, typename T,
+          std::enable_if_t<IsSetContainer<T>, int> = 0>
+inline void FormatJsonValue(Stream& ss, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+inline void FormatJsonValue(Stream& ss, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+inline void FormatJsonValue(Stream& ss, const T&);
+
 template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int> = 0>
 inline void FormatJsonValue(Stream& s, const T&);
 
@@ -122,10 +157,9 @@ inline void FormatJsonKey(Stream& s, T&& t) {
 
 template <typename Stream, typename T, std::enable_if_t<IsNonCharArray<T>, int>>
 inline void FormatJsonValue(Stream& ss, const T& v) {
-    ss.push_back('[');
-    _::Join(ss, std::begin(v), std::end(v), ',',
-            [&ss](const auto& jsv) constexpr { FormatJsonValue(ss, jsv); });
-    ss.push_back(']');
+    _::JoinArray(ss, std::begin(v), std::end(v), [&ss](const auto& jsv) {
+        FormatJsonValue(ss, jsv);
+    });
 }
 
 // notes, in c-style programming, we usually use a char array to store a string
@@ -147,34 +181,27 @@ inline void FormatJsonValue(Stream& ss, const T& v) {
 
 template <typename Stream, typename T, std::enable_if_t<IsMapContainer<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& v) {
-    s.push_back('{');
-    _::Join(s, v.cbegin(), v.cend(), ',', [&s](const auto& jsv) constexpr {
+    _::JoinObject(s, v.cbegin(), v.cend(), [&s](const auto& jsv) constexpr {
         _::FormatJsonKey(s, jsv.first);
-        s.push_back(':');
+        s.NameSeparator();
         FormatJsonValue(s, jsv.second);
     });
-    s.push_back('}');
 }
 
-template <typename Stream, typename T,
-          std::enable_if_t<IsSetContainer<T>, int> = 0>
+template <typename Stream, typename T, std::enable_if_t<IsSetContainer<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& v) {
-    s.push_back('[');
-    _::Join(s, v.cbegin(), v.cend(), ',',
-            [&s](const auto& jsv) constexpr { FormatJsonValue(s, jsv); });
-    s.push_back(']');
+    _::JoinArray(s, v.cbegin(), v.cend(),
+                 [&s](const auto& jsv) constexpr { FormatJsonValue(s, jsv); });
 }
 
 template <typename Stream, typename T,
           std::enable_if_t<IsSequenceContainer<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& v) {
-    s.push_back('[');
-    _::Join(s, v.cbegin(), v.cend(), ',',
-            [&s](const auto& jsv) constexpr { FormatJsonValue(s, jsv); });
-    s.push_back(']');
+    _::JoinArray(s, v.cbegin(), v.cend(),
+                 [&s](const auto& jsv) constexpr { FormatJsonValue(s, jsv); });
 }
 
-template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& v) {
     if (v) {
         FormatJsonValue(s, *v);
@@ -187,39 +214,45 @@ template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& t) {
     using U = typename std::decay_t<T>;
     constexpr std::size_t size = std::tuple_size_v<U>;
-    s.push_back('[');
+    if constexpr (size == 0) {
+        s.EmptyArray();
+        return;
+    }
 
-    ForEach(t, [&s, size](auto idx, const auto& v) constexpr {
+    s.BeginArray();
+    ForEach(t, [&s](auto idx, const auto& v) constexpr {
         FormatJsonValue(s, v);
-        if (idx != size - 1) {
-            s.push_back(',');
+        if constexpr (decltype(idx)::value != size - 1) {
+            s.ValueSeparator();
         }
     });
-
-    s.push_back(']');
+    s.EndArray();
 }
 
 template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& t) {
-    std::visit([&s](auto value) { FormatJsonValue(s, value); }, t);
+    std::visit([&s](const auto& value) { FormatJsonValue(s, value); }, t);
 }
 
 template <typename Stream, typename T,
-          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+          std::enable_if_t<IsAggregateStruct<T>, int>>
 inline void FormatJsonValue(Stream& s, const T& t) {
-    s.push_back('{');
-
     constexpr auto& fields = ::reflpp::kFieldNames<T>;
+    if constexpr (fields.size() == 0) {
+        s.EmptyObject();
+        return;
+    }
+
+    s.BeginObject();
     ForEach(t, [&](auto idx, const auto& v) constexpr {
         _::FormatJsonKey(s, fields[idx]);
-        s.push_back(':');
+        s.NameSeparator();
         FormatJsonValue(s, v);
-        if (idx < fields.size() - 1) {
-            s.push_back(',');
+        if constexpr (decltype(idx)::value < fields.size() - 1) {
+            s.ValueSeparator();
         }
     });
-
-    s.push_back('}');
+    s.EndObject();
 }
 
 template <typename Stream, typename T,
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <json/json_writer.h>
+#include <json/pretty_formatter.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace reflpp {
+namespace json {
+
+struct ParallelOptions {
+    // the number of threads, including the caller thread
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // the container is split only if every chunk gets at least so many
+    // elements. notes, each chunk is formatted into its own buffer, which is
+    // copied into the stream at last, so that the small chunks are slower
+    std::size_t min_chunk_size = 4096;
+};
+
+namespace _ {
+
+template <typename T, typename = void>
+struct IsRandomAccessContainerImpl : std::false_type {};
+
+template <typename T>
+struct IsRandomAccessContainerImpl<T, std::enable_if_t<IsSequenceContainer<T>>>
+    : std::bool_constant<std::random_access_iterator<
+          typename RemoveCVRef<T>::const_iterator>> {};
+
+template <typename T>
+inline constexpr bool IsRandomAccessContainer =
+    IsRandomAccessContainerImpl<T>::value;
+
+}  // namespace _
+
+// ParallelFormatter marks the stream that large sequence containers are
+// formatted in parallel. the chunks are formatted into the forked formatters,
+// so that the nested containers of a chunk are formatted serially
+template <typename Formatter>
+class ParallelFormatter : public Formatter {
+   public:
+    ParallelFormatter(Formatter&& f, const ParallelOptions& opts)
+        : Formatter(std::move(f)), opts_(opts) {}
+
+    const ParallelOptions& options() const { return opts_; }
+
+   private:
+    const ParallelOptions& opts_;
+};
+
+template <typename Formatter, typename T,
+          std::enable_if_t<_::IsRandomAccessContainer<T>, int> = 0>
+inline void FormatJsonValue(ParallelFormatter<Formatter>& s, const T& v) {
+    const auto& opts = s.options();
+    const std::size_t size = v.size();
+    const std::size_t chunks = std::min(
+        opts.threads, size / std::max<std::size_t>(1, opts.min_chunk_size));
+
+    if (chunks < 2) {
+        _::JoinArray(s, v.cbegin(), v.cend(), [&s](const auto& jsv) {
+            FormatJsonValue(s, jsv);
+        });
+        return;
+    }
+
+    s.BeginArray();
+
+    // the elements in the chunks are at the same depth as the first element
+    std::vector<typename Formatter::ForkFormatter> buffers;
+    buffers.reserve(chunks);
+    for (std::size_t i = 0; i < chunks; ++i) {
+        buffers.emplace_back(s.Fork());
+    }
+
+    auto format_chunk = [&v, &buffers, size, chunks](std::size_t i) {
+        auto first = v.cbegin() + size * i / chunks;
+        auto last = v.cbegin() + size * (i + 1) / chunks;
+        auto& buf = buffers[i];
+        _::Join(buf, first, last,
+                [&buf](const auto& jsv) { FormatJsonValue(buf, jsv); });
+    };
+
+    // the first chunk is formatted by the caller thread
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks - 1);
+    for (std::size_t i = 1; i < chunks; ++i) {
+        futures.emplace_back(std::async(std::launch::async, format_chunk, i));
+    }
+    format_chunk(0);
+
+    for (std::size_t i = 0; i < chunks; ++i) {
+        if (i > 0) {
+            futures[i - 1].get();
+            s.ValueSeparator();
+        }
+        s.append(buffers[i].data(), buffers[i].size());
+    }
+
+    s.EndArray();
+}
+
+// ToJsonParallel produces the byte-identical output to ToJson, but the large
+// random access containers, e.g. std::vector and std::deque, are split into
+// chunks which are formatted by multiple threads
+template <typename Stream, typename T,
+          std::enable_if_t<
+              IsAggregateStruct<T> || _::IsRandomAccessContainer<T>, int> _ = 0>
+inline void ToJsonParallel(Stream& s, const T& t,
+                           const ParallelOptions& opts = {}) {
+    ParallelFormatter<Stream> ps(std::move(s), opts);
+    FormatJsonValue(ps, t);
+    s = std::move(static_cast<Stream&>(ps));
+}
+
+}  // namespace json
+}  // namespace reflpp
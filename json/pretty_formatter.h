@@ -1,11 +1,17 @@
 #pragma once
 
-#include <cstring>
+#include <cstddef>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace reflpp {
 namespace json {
 namespace _ {
+
+// Formatter receives the structural events (begin/end of object and array,
+// separators) from FormatJsonValue. Scalars are appended as is, so the
+// pretty layout is written directly instead of re-lexing the compact output
 template <typename Stream, bool Pretty = false, std::size_t Indent = 4>
 class Formatter : public Stream {
    public:
@@ -15,7 +21,13 @@ class Formatter : public Stream {
     using Stream::reserve;
 
     Formatter() = default;
-    Formatter(size_type init_cap) { Stream::Reserve(init_cap); }
+    Formatter(size_type init_cap) { Stream::reserve(init_cap); }
+
+    // constructs the underlying stream with the arguments, e.g. the fixed
+    // buffer which has no default storage
+    template <typename... Args>
+    explicit Formatter(std::in_place_t, Args&&... args)
+        : Stream(std::forward<Args>(args)...) {}
 
     Formatter(Formatter&&) = default;
     Formatter(const Formatter&) = delete;
@@ -24,165 +36,93 @@ class Formatter : public Stream {
 
    public:
     Formatter& append(size_type count, value_type ch) {
-        if constexpr (!Pretty) {
-            Stream::append(count, ch);
-        } else {
-            for (size_type i = 0; i < count; ++i) {
-                PrettyFormat(ch);
-            }
-        }
-
+        Stream::append(count, ch);
         return *this;
     }
 
     Formatter& append(const value_type* s) {
-        if constexpr (!Pretty) {
-            Stream::append(s);
-        } else {
-            for (std::size_t i = 0; i < std::strlen(s); ++i) {
-                PrettyFormat(s[i]);
-            }
-        }
-
+        Stream::append(s);
         return *this;
     }
 
     Formatter& append(const value_type* s, size_type count) {
-        if constexpr (!Pretty) {
-            Stream::append(s, count);
-        } else {
-            for (size_type i = 0; i < count; ++i) {
-                PrettyFormat(s[i]);
-            }
-        }
-
+        Stream::append(s, count);
         return *this;
     }
 
-    void push_back(value_type c) {
-        if constexpr (!Pretty) {
-            Stream::push_back(c);
-        } else {
-            PrettyFormat(c);
-        }
-    }
+    void push_back(value_type c) { Stream::push_back(c); }
 
     Stream& stream() { return *this; }
     const Stream& stream() const { return *this; }
 
-   private:
-    enum State {
-        kNormal,
-        kEscaped,
-        kString,
-        kBeforeAsterisk,
-        kComment,
-        kBeforeFlash,
-    };
-
-    void NewLine() {
-        if constexpr (Pretty) {
-            Stream::push_back('\n');
-            Stream::append(indent_ * Indent, ' ');
-        }
+    // the stream of the forked formatters, notes, the stream without the
+    // default storage, e.g. the fixed buffer, is forked into std::string
+    using ForkStream =
+        std::conditional_t<std::is_default_constructible_v<Stream>, Stream,
+                           std::string>;
+    using ForkFormatter = Formatter<ForkStream, Pretty, Indent>;
+
+    // returns an empty formatter at the same nesting depth, the output of which
+    // can be spliced into this formatter, e.g. the chunks formatted in parallel
+    ForkFormatter Fork() const {
+        ForkFormatter f;
+        f.indent_ = indent_;
+        return f;
     }
 
-    void CommentStart() {
+   public:
+    void BeginObject() { BeginScope('{'); }
+    void EndObject() { EndScope('}'); }
+
+    void BeginArray() { BeginScope('['); }
+    void EndArray() { EndScope(']'); }
+
+    // notes, the empty object and array keep on one line, e.g. `{}` and `[]`
+    void EmptyObject() { Stream::append("{}", 2); }
+    void EmptyArray() { Stream::append("[]", 2); }
+
+    // the separator between key and value
+    void NameSeparator() {
         if constexpr (Pretty) {
-            Stream::append(" /");
+            Stream::append(": ", 2);
         } else {
-            Stream::push_back("/");
+            Stream::push_back(':');
         }
     }
 
-    void ValueStart() {
-        if constexpr (Pretty) {
-            Stream::append(": ");
-        } else {
-            Stream::push_back(":");
-        }
+    // the separator between elements of object or array
+    void ValueSeparator() {
+        Stream::push_back(',');
+        NewLine();
     }
 
-    void FormatChar(char c) {
-        switch (c) {
-            case ' ':
-            case '\n':
-            case '\r':
-            case '\t':
-                break;
-            case ',':
-                Stream::push_back(c);
-                NewLine();
-                break;
-            case '[':
-            case '{':
-                Stream::push_back(c);
-                ++indent_;
-                NewLine();
-                break;
-            case ']':
-            case '}':
-                --indent_;
-                NewLine();
-                Stream::push_back(c);
-                break;
-            case '\\':
-                Stream::push_back(c);
-                state_ = State::kEscaped;
-                break;
-            case '\"':
-                Stream::push_back(c);
-                state_ = State::kString;
-                break;
-            case '/':
-                CommentStart();
-                state_ = State::kBeforeAsterisk;
-                break;
-            case ':':
-                ValueStart();
-                break;
-            default:
-                Stream::push_back(c);
-                break;
+   private:
+    void NewLine() {
+        if constexpr (Pretty) {
+            Stream::push_back('\n');
+            Stream::append(indent_ * Indent, ' ');
         }
     }
 
-    void FormatOther(char c) {
-        switch (state_) {
-            case State::kEscaped:
-                state_ = State::kNormal;
-                break;
-            case State::kString:
-                if (c == '\"') {
-                    state_ = State::kNormal;
-                }
-                break;
-            case State::kBeforeAsterisk:
-                state_ = State::kComment;
-                break;
-            case State::kComment:
-                if (c == '*') {
-                    state_ = State::kBeforeFlash;
-                }
-                break;
-            case State::kBeforeFlash:
-                state_ = (c == '/') ? State::kNormal : State::kComment;
-                break;
-            default:
-                break;
+    void BeginScope(value_type c) {
+        Stream::push_back(c);
+        if constexpr (Pretty) {
+            ++indent_;
+            NewLine();
         }
     }
 
-    void PrettyFormat(char c) {
-        if (state_ == State::kNormal) {
-            FormatChar(c);
-        } else {
-            Stream::push_back(c);
-            FormatOther(c);
+    void EndScope(value_type c) {
+        if constexpr (Pretty) {
+            --indent_;
+            NewLine();
         }
+        Stream::push_back(c);
     }
 
-    State state_{kNormal};
+    template <typename, bool, std::size_t>
+    friend class Formatter;
+
     std::size_t indent_{0};
 };
 }  // namespace _
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <field_name.h>
+#include <json/json_writer.h>
+#include <tracked.h>
+
+#include <string>
+#include <utility>
+
+namespace reflpp {
+namespace json {
+
+namespace _ {
+
+// the address identifies the stream type which produces the fragments, as the
+// compact and pretty fragments are different
+template <typename Stream>
+inline constexpr char kFragmentTag = 0;
+
+template <typename Stream, typename T, std::size_t... Is>
+inline void FormatTrackedObject(Stream& s, Tracked<T>& t,
+                                std::index_sequence<Is...>) {
+    constexpr auto& fields = ::reflpp::kFieldNames<T>;
+    auto& cache = t.cache();
+
+    // the fragments of the other stream type are useless
+    if (cache.tag != &kFragmentTag<Stream>) {
+        cache.tag = &kFragmentTag<Stream>;
+        t.MarkAllDirty();
+    }
+
+    auto refresh = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+        if (!t.IsDirty(I)) return;
+
+        // the fragment is at the same depth as the fields of the object
+        auto fragment = s.Fork();
+        FormatJsonValue(fragment, t.template Get<I>());
+        cache.fragments[I].assign(fragment.data(), fragment.size());
+    };
+
+    s.BeginObject();
+    (refresh(std::integral_constant<std::size_t, Is>{}), ...);
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) {
+            s.ValueSeparator();
+        }
+        FormatJsonKey(s, fields[i]);
+        s.NameSeparator();
+        s.append(cache.fragments[i].data(), cache.fragments[i].size());
+    }
+    s.EndObject();
+
+    t.ClearDirty();
+}
+
+}  // namespace _
+
+// notes, the fragments are formatted at the depth of a top-level object, so the
+// tracked object should be serialized as a document rather than nested
+template <typename Stream, typename T>
+inline void ToJson(Stream& s, Tracked<T>& t) {
+    constexpr std::size_t N = Tracked<T>::kFieldsCount;
+    if constexpr (N == 0) {
+        s.EmptyObject();
+    } else {
+        _::FormatTrackedObject(s, t, std::make_index_sequence<N>{});
+    }
+}
+
+}  // namespace json
+}  // namespace reflpp
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <field_access.h>
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+#include <utils.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <source_location>
+#include <string_view>
+#include <utility>
+
+// the layout of the aggregate struct, i.e., the offsets, the padding bytes,
+// and the field order without the padding between fields. notes, since the
+// size is the multiple of the alignment for any type, placing the fields by
+// decreasing alignment leaves only the tail padding, which is the smallest.
+// the alignments are of the field types, except for the fields moved by
+// alignas, whose alignments are estimated from their offsets
+namespace reflpp {
+
+struct FieldLayoutInfo {
+    std::string_view name;
+    std::size_t offset{0};
+    std::size_t size{0};
+    std::size_t align{0};
+
+    // the padding bytes before the field
+    std::size_t padding{0};
+};
+
+template <std::size_t N>
+struct StructLayout {
+    std::size_t size{0};
+    std::size_t align{0};
+    std::array<FieldLayoutInfo, N> fields{};
+
+    // the padding bytes in total, including the tail padding
+    std::size_t padding{0};
+    std::size_t tail_padding{0};
+
+    // the indexes of fields in the best order, and the size in that order
+    std::array<std::size_t, N> best_order{};
+    std::size_t best_size{0};
+
+    constexpr std::size_t saving() const { return size - best_size; }
+};
+
+namespace _ {
+
+template <typename T>
+constexpr std::string_view TypeSignature() noexcept {
+    return std::source_location::current().function_name();
+}
+
+template <typename T>
+constexpr std::string_view ExtractTypeName() noexcept {
+#if defined(__GNUC__)
+    // e.g., "... TypeSignature() [with T = Foo; std::string_view = ...]"
+    constexpr std::string_view kPrefix = "[with T = ";
+
+    std::string_view sig = TypeSignature<T>();
+    auto start = sig.find(kPrefix);
+    if (start == std::string_view::npos) {
+        return {};
+    }
+    start += kPrefix.size();
+
+    auto end = sig.find_first_of(";]", start);
+    return sig.substr(start, end - start);
+#else
+    // TODO: support clang compiler
+    static_assert(false, "Unsupported compiler");
+#endif
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetStructLayoutImpl(std::index_sequence<Is...>) {
+    constexpr std::size_t N = sizeof...(Is);
+
+    StructLayout<N> layout;
+    layout.size = sizeof(T);
+    layout.align = alignof(T);
+
+    std::size_t end = 0;
+    if constexpr (N > 0) {
+        constexpr auto offsets = GetFieldOffsets<T>();
+        constexpr std::array<std::size_t, N> sizes{
+            sizeof(FieldType<Is, T>)...};
+        std::array<std::size_t, N> aligns{alignof(FieldType<Is, T>)...};
+
+        for (std::size_t i = 0; i < N; ++i) {
+            // notes, the field is moved by alignas if it's placed after its
+            // predicted offset, and its alignment is at most the largest
+            // power of two which divides the offset
+            if (offsets[i] > AlignUp(end, aligns[i])) {
+                aligns[i] = std::min(offsets[i] & (~offsets[i] + 1),
+                                     layout.align);
+            }
+
+            auto& field = layout.fields[i];
+            field.name = kFieldNames<T>[i];
+            field.offset = offsets[i];
+            field.size = sizes[i];
+            field.align = aligns[i];
+            // notes, the fields with [[no_unique_address]] may overlap
+            field.padding = offsets[i] > end ? offsets[i] - end : 0;
+
+            layout.padding += field.padding;
+            end = std::max(end, offsets[i] + sizes[i]);
+        }
+
+        // the stable insertion sort by decreasing alignment
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t j = i;
+            for (; j > 0 && aligns[layout.best_order[j - 1]] < aligns[i]; --j) {
+                layout.best_order[j] = layout.best_order[j - 1];
+            }
+            layout.best_order[j] = i;
+        }
+
+        std::size_t best_end = 0;
+        for (auto i : layout.best_order) {
+            best_end = AlignUp(best_end, aligns[i]) + sizes[i];
+        }
+        layout.best_size = AlignUp(best_end, layout.align);
+    } else {
+        layout.best_size = sizeof(T);
+    }
+
+    layout.tail_padding = layout.size - end;
+    layout.padding += layout.tail_padding;
+    return layout;
+}
+
+}  // namespace _
+
+template <typename T>
+consteval auto GetTypeName() {
+    return _::ExtractTypeName<T>();
+}
+
+template <typename T>
+consteval auto GetStructLayout() {
+    return _::GetStructLayoutImpl<T>(
+        std::make_index_sequence<FieldsCount<T>()>{});
+}
+
+template <typename T>
+inline constexpr auto kStructLayout = GetStructLayout<T>();
+
+// writes the readable report of the layout, e.g.,
+//   Order: size 32, align 8, padding 11 (34.4%)
+//     offset   size  align    pad  field
+//          0      1      1      0  side
+//          8      8      8      7  id
+//     ...
+//     best order: id, price, qty, side (size 24, saves 8 bytes per object)
+template <typename T, typename Stream>
+void FormatLayoutReport(Stream& s) {
+    constexpr auto& layout = kStructLayout<T>;
+    auto out = std::back_inserter(s);
+
+    fmt::format_to(out, "{}: size {}, align {}, padding {} ({:.1f}%)\n",
+                   GetTypeName<T>(), layout.size, layout.align, layout.padding,
+                   100.0 * layout.padding / layout.size);
+    fmt::format_to(out, "  {:>6} {:>6} {:>6} {:>6}  field\n", "offset", "size",
+                   "align", "pad");
+    for (const auto& field : layout.fields) {
+        fmt::format_to(out, "  {:>6} {:>6} {:>6} {:>6}  {}\n", field.offset,
+                       field.size, field.align, field.padding, field.name);
+    }
+    if (layout.tail_padding > 0) {
+        fmt::format_to(out, "  {:>6} {:>6} {:>6} {:>6}  (tail)\n",
+                       layout.size - layout.tail_padding, "", "",
+                       layout.tail_padding);
+    }
+
+    if (layout.saving() > 0) {
+        fmt::format_to(out, "  best order: ");
+        for (std::size_t i = 0; i < layout.best_order.size(); ++i) {
+            if (i > 0) fmt::format_to(out, ", ");
+            fmt::format_to(out, "{}", layout.fields[layout.best_order[i]].name);
+        }
+        fmt::format_to(out, " (size {}, saves {} bytes per object)\n",
+                       layout.best_size, layout.saving());
+    } else {
+        fmt::format_to(out, "  the field order is the best\n");
+    }
+}
+
+}  // namespace reflpp
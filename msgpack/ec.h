@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+#define MSGPACK_ERROR_LIST(__)                            \
+    __(kOk, "OK")                                         \
+    __(kErrorUnexpectedTerminate, "Unexpected terminate") \
+    __(kErrorParseFailure, "Parse failure")               \
+    __(kErrorMismatchType, "Mismatch type")               \
+    __(kErrorArrayOutOfRange, "Array out of range")       \
+    __(kErrorIntegerOverflow, "Integer overflow")         \
+    __(kErrorInvalidUtf8Char, "Invalid utf8 char")
+
+namespace reflpp {
+namespace msgpack {
+
+// clang-format off
+enum ErrorCode {
+#define __(A, B) A,
+    MSGPACK_ERROR_LIST(__)
+#undef __
+};
+// clang-format on
+
+struct MsgPackErrorCategory : public std::error_category {
+    const char* name() const noexcept override { return "msgpack error"; }
+
+    // clang-format off
+    std::string message(int ec) const override {
+        switch (ec) {
+#define __(A, B) case A: return B;
+        MSGPACK_ERROR_LIST(__)
+#undef __
+        }
+        return "unknown error code";
+    }
+    // clang-format on
+};
+
+inline const MsgPackErrorCategory error_category;
+
+inline std::error_code make_error(int ec) { return {ec, error_category}; }
+
+}  // namespace msgpack
+}  // namespace reflpp
@@ -0,0 +1,778 @@
+#pragma once
+
+#include <byte_order.h>
+#include <field_name.h>
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <for_each.h>
+#include <json/utf8.h>
+#include <msgpack/ec.h>
+#include <msgpack/msgpack_writer.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace reflpp {
+namespace msgpack {
+
+namespace _ {
+
+// returns the family of the tag, which is used by the error message
+inline const char* TagString(std::uint8_t tag) {
+    if (tag <= 0x7f || tag >= 0xe0) return "int";
+    if (tag <= 0x8f) return "map";
+    if (tag <= 0x9f) return "array";
+    if (tag <= 0xbf) return "str";
+
+    switch (tag) {
+        case 0xc0:
+            return "nil";
+        case 0xc2:
+        case 0xc3:
+            return "bool";
+        case 0xc4:
+        case 0xc5:
+        case 0xc6:
+            return "bin";
+        case 0xc7:
+        case 0xc8:
+        case 0xc9:
+        case 0xd4 ... 0xd8:
+            return "ext";
+        case 0xca:
+        case 0xcb:
+            return "float";
+        case 0xcc ... 0xd3:
+            return "int";
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            return "str";
+        case 0xdc:
+        case 0xdd:
+            return "array";
+        case 0xde:
+        case 0xdf:
+            return "map";
+        default:
+            return "never used";
+    }
+}
+
+struct Unpacker {
+    Unpacker(std::string_view data) : data_(data) {}
+
+    Unpacker(Unpacker&&) = default;
+    Unpacker& operator=(Unpacker&&) = default;
+
+    Unpacker(const Unpacker&) = delete;
+    Unpacker& operator=(const Unpacker&) = delete;
+
+    // notes, only the first error is kept
+    bool E(int ec) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = error_category.message(ec);
+        }
+        return false;
+    }
+
+    template <typename... Args>
+    bool E(int ec, const char* fmt, const Args&... args) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        return false;
+    }
+
+    bool IsEof() const { return cursor_ >= data_.size(); }
+    bool IsError() const { return static_cast<bool>(ec_); }
+
+    std::error_code error() const { return ec_; }
+    std::string_view detail_error() const { return detail_emsg_; }
+
+    // returns the tag of the next value without consuming it
+    std::uint8_t Peek() const {
+        return IsEof() ? 0xc1 : static_cast<std::uint8_t>(data_[cursor_]);
+    }
+
+    bool IsNil() const { return Peek() == 0xc0; }
+    bool IsMap() const {
+        auto tag = Peek();
+        return (tag >= 0x80 && tag <= 0x8f) || tag == 0xde || tag == 0xdf;
+    }
+    bool IsExt() const {
+        auto tag = Peek();
+        return (tag >= 0xd4 && tag <= 0xd8) || (tag >= 0xc7 && tag <= 0xc9);
+    }
+
+    inline bool Take(std::size_t n, const char** p);
+    inline bool ReadByte(std::uint8_t* b);
+
+    template <typename T>
+    inline bool ReadBigEndian(T* v);
+
+    inline bool ReadNil();
+    inline bool ReadBool(bool* v);
+    inline bool ReadArrayHeader(std::size_t* n);
+    inline bool ReadMapHeader(std::size_t* n);
+    inline bool ReadStr(std::string_view* str);
+    inline bool ReadExt(std::int8_t* type, std::string_view* payload);
+
+    template <typename T>
+    inline bool ReadInt(T* v);
+
+    template <typename T>
+    inline bool ReadFloat(T* v);
+
+    inline bool Skip();
+
+    template <typename T, typename U>
+    bool AssignInt(T* v, U u) {
+        if (!std::in_range<T>(u)) {
+            return E(kErrorIntegerOverflow, "integer {} is out of range", u);
+        }
+        *v = static_cast<T>(u);
+        return true;
+    }
+
+    template <typename U, typename T>
+    bool ReadIntAs(T* v) {
+        U u;
+        return ReadBigEndian(&u) && AssignInt(v, u);
+    }
+
+    // reads the 8-bit, 16-bit or 32-bit length
+    template <typename U>
+    bool ReadLength(std::size_t* n) {
+        U u;
+        if (!ReadBigEndian(&u)) return false;
+        *n = u;
+        return true;
+    }
+
+    bool Mismatch(const char* expect, std::uint8_t tag) {
+        return E(kErrorMismatchType, "expect `{}` but got `{}`", expect,
+                 TagString(tag));
+    }
+
+    std::error_code ec_;
+    std::string detail_emsg_;
+
+    std::size_t cursor_{0};
+    std::string_view data_;
+};
+
+template <typename T>
+using FieldParser = void (*)(Unpacker&, T&);
+
+template <std::size_t I, typename T>
+void ParseFieldAt(Unpacker& u, T& value) {
+    ParseItem(u, GetField<I>(value));
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldParsersImpl(std::index_sequence<Is...>) {
+    return std::array<FieldParser<T>, sizeof...(Is)>{&ParseFieldAt<Is, T>...};
+}
+
+// the parsers of fields, which are indexed by the field index, so that the
+// field is parsed without visiting the others
+template <typename T>
+inline constexpr auto kFieldParsers =
+    GetFieldParsersImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+void ParseItem(Unpacker& u, T& value) {
+    constexpr auto& fields = ::reflpp::kFieldNames<T>;
+    std::size_t n = 0;
+
+    if (u.IsMap()) {
+        if (!u.ReadMapHeader(&n)) return;
+
+        for (std::size_t i = 0; i < n && !u.IsError(); ++i) {
+            std::string_view key;
+            if (!u.ReadStr(&key)) return;
+
+            // for compatibility, here ignore unknown fields
+            auto itr = std::find(fields.begin(), fields.end(), key);
+            if (itr == fields.end()) {
+                u.Skip();
+                continue;
+            }
+
+            kFieldParsers<T>[itr - fields.begin()](u, value);
+        }
+        return;
+    }
+
+    if (!u.ReadArrayHeader(&n)) return;
+
+    // the missing fields keep unchanged, and the extra ones are ignored
+    ForEach(value, [&u, n](auto i, auto& v) {
+        if (i >= n || u.IsError()) return;
+        ParseItem(u, v);
+    });
+    for (std::size_t i = fields.size(); i < n && !u.IsError(); ++i) {
+        u.Skip();
+    }
+}
+
+template <typename T, std::enable_if_t<IsBool<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    u.ReadBool(&value);
+}
+
+template <typename T, std::enable_if_t<IsIntegral<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    u.ReadInt(&value);
+}
+
+template <typename T, std::enable_if_t<IsFloat<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    u.ReadFloat(&value);
+}
+
+template <typename T, std::enable_if_t<IsChar<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    std::string_view str;
+    if (!u.ReadStr(&str)) return;
+
+    std::uint32_t codepoint = 0;
+    auto opt = Utf8DfaDecoder::Decode(str.data(), str.size(), &codepoint);
+    if (!opt || opt.value() != str.size()) {
+        u.E(kErrorMismatchType, "invalid char");
+        return;
+    }
+    value = codepoint;
+}
+
+template <typename T, std::enable_if_t<IsString<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    std::string_view str;
+    if (u.ReadStr(&str)) {
+        value.assign(str.begin(), str.end());
+    }
+}
+
+template <typename T, std::enable_if_t<IsMapContainer<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    using U = std::remove_reference_t<T>;
+    using KeyType = typename U::key_type;
+
+    std::size_t n = 0;
+    if (!u.ReadMapHeader(&n)) return;
+
+    value.clear();
+    for (std::size_t i = 0; i < n && !u.IsError(); ++i) {
+        KeyType key{};
+        ParseItem(u, key);
+        ParseItem(u, value[std::move(key)]);
+    }
+}
+
+template <typename T>
+bool ReadTypedArray(Unpacker& u, std::string_view* payload) {
+    std::int8_t type = 0;
+    if (!u.ReadExt(&type, payload)) return false;
+
+    if (type != TypedArrayExtType<T>() || payload->size() % sizeof(T) != 0) {
+        return u.E(kErrorMismatchType, "unexpected ext type {}", type);
+    }
+    return true;
+}
+
+template <typename T>
+void CopyTypedArray(T* dst, std::string_view payload) {
+    if constexpr (std::endian::native == std::endian::little) {
+        // notes, the destination of the empty array may be null
+        if (!payload.empty()) {
+            std::memcpy(dst, payload.data(), payload.size());
+        }
+    } else {
+        for (std::size_t i = 0; i < payload.size() / sizeof(T); ++i) {
+            dst[i] = LoadLittleEndian<T>(payload.data() + i * sizeof(T));
+        }
+    }
+}
+
+template <typename T, std::enable_if_t<IsSequenceContainer<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    if constexpr (IsTypedArray<T>) {
+        if (u.IsExt()) {
+            using U = typename T::value_type;
+
+            std::string_view payload;
+            if (ReadTypedArray<U>(u, &payload)) {
+                value.resize(payload.size() / sizeof(U));
+                CopyTypedArray(value.data(), payload);
+            }
+            return;
+        }
+    }
+
+    std::size_t n = 0;
+    if (!u.ReadArrayHeader(&n)) return;
+
+    value.clear();
+    for (std::size_t i = 0; i < n && !u.IsError(); ++i) {
+        ParseItem(u, value.emplace_back());
+    }
+}
+
+template <typename T, std::enable_if_t<IsSetContainer<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    using U = std::remove_reference_t<T>;
+    using KeyType = typename U::key_type;
+
+    std::size_t n = 0;
+    if (!u.ReadArrayHeader(&n)) return;
+
+    value.clear();
+    for (std::size_t i = 0; i < n && !u.IsError(); ++i) {
+        KeyType v{};
+        ParseItem(u, v);
+        value.insert(std::move(v));
+    }
+}
+
+template <typename T, std::enable_if_t<IsOptional<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    using U = std::remove_reference_t<T>;
+    using ValueType = typename U::value_type;
+
+    if (u.ReadNil()) {
+        value = std::nullopt;
+    } else {
+        ValueType v{};
+        ParseItem(u, v);
+        value = std::move(v);
+    }
+}
+
+template <typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    using U = std::remove_reference_t<T>;
+    using ValueType = typename U::element_type;
+
+    if (u.ReadNil()) {
+        value = nullptr;
+    } else {
+        if constexpr (IsUniquePtr<T>) {
+            value = std::make_unique<ValueType>();
+        } else {
+            value = std::make_shared<ValueType>();
+        }
+        ParseItem(u, *value);
+    }
+}
+
+template <typename T, std::size_t... Is>
+void ParseTuple(Unpacker& u, T& value, std::size_t n,
+                std::index_sequence<Is...>) {
+    ((Is < n && !u.IsError() ? ParseItem(u, std::get<Is>(value)) : void()),
+     ...);
+}
+
+template <typename T, std::enable_if_t<IsTuple<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    constexpr std::size_t size = std::tuple_size_v<T>;
+
+    std::size_t n = 0;
+    if (!u.ReadArrayHeader(&n)) return;
+
+    ParseTuple(u, value, n, std::make_index_sequence<size>{});
+    for (std::size_t i = size; i < n && !u.IsError(); ++i) {
+        u.Skip();
+    }
+}
+
+template <typename T, std::enable_if_t<IsCharArray<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    constexpr std::size_t n = sizeof(T) / sizeof(value[0]);
+
+    std::string_view str;
+    if (!u.ReadStr(&str)) return;
+
+    if (str.size() > n) {
+        u.E(kErrorArrayOutOfRange);
+        return;
+    }
+
+    std::copy(str.begin(), str.end(), std::begin(value));
+    if (str.size() < n) {
+        value[str.size()] = '\0';
+    }
+}
+
+template <typename T, std::enable_if_t<IsNonCharArray<T>, int> = 0>
+void ParseItem(Unpacker& u, T& value) {
+    constexpr std::size_t size = sizeof(T) / sizeof(value[0]);
+
+    if constexpr (IsTypedArray<T>) {
+        if (u.IsExt()) {
+            using U = std::remove_reference_t<decltype(value[0])>;
+
+            std::string_view payload;
+            if (!ReadTypedArray<U>(u, &payload)) return;
+
+            if (payload.size() / sizeof(U) > size) {
+                u.E(kErrorArrayOutOfRange);
+                return;
+            }
+            CopyTypedArray(std::data(value), payload);
+            return;
+        }
+    }
+
+    std::size_t n = 0;
+    if (!u.ReadArrayHeader(&n)) return;
+
+    if (n > size) {
+        u.E(kErrorArrayOutOfRange);
+        return;
+    }
+
+    for (std::size_t i = 0; i < n && !u.IsError(); ++i) {
+        ParseItem(u, value[i]);
+    }
+}
+
+inline bool Unpacker::Take(std::size_t n, const char** p) {
+    if (IsError()) return false;
+
+    if (data_.size() - cursor_ < n) {
+        return E(kErrorUnexpectedTerminate);
+    }
+
+    *p = data_.data() + cursor_;
+    cursor_ += n;
+    return true;
+}
+
+inline bool Unpacker::ReadByte(std::uint8_t* b) {
+    const char* p = nullptr;
+    if (!Take(1, &p)) return false;
+
+    *b = static_cast<std::uint8_t>(*p);
+    return true;
+}
+
+template <typename T>
+inline bool Unpacker::ReadBigEndian(T* v) {
+    const char* p = nullptr;
+    if (!Take(sizeof(T), &p)) return false;
+
+    *v = LoadBigEndian<T>(p);
+    return true;
+}
+
+inline bool Unpacker::ReadNil() {
+    if (IsError() || !IsNil()) return false;
+
+    ++cursor_;
+    return true;
+}
+
+inline bool Unpacker::ReadBool(bool* v) {
+    std::uint8_t tag = 0;
+    if (!ReadByte(&tag)) return false;
+
+    if (tag != 0xc2 && tag != 0xc3) {
+        return Mismatch("bool", tag);
+    }
+    *v = tag == 0xc3;
+    return true;
+}
+
+inline bool Unpacker::ReadArrayHeader(std::size_t* n) {
+    std::uint8_t tag = 0;
+    if (!ReadByte(&tag)) return false;
+
+    if (tag >= 0x90 && tag <= 0x9f) {
+        *n = tag & 0x0f;
+        return true;
+    }
+
+    switch (tag) {
+        case 0xdc:
+            return ReadLength<std::uint16_t>(n);
+        case 0xdd:
+            return ReadLength<std::uint32_t>(n);
+        default:
+            return Mismatch("array", tag);
+    }
+}
+
+inline bool Unpacker::ReadMapHeader(std::size_t* n) {
+    std::uint8_t tag = 0;
+    if (!ReadByte(&tag)) return false;
+
+    if (tag >= 0x80 && tag <= 0x8f) {
+        *n = tag & 0x0f;
+        return true;
+    }
+
+    switch (tag) {
+        case 0xde:
+            return ReadLength<std::uint16_t>(n);
+        case 0xdf:
+            return ReadLength<std::uint32_t>(n);
+        default:
+            return Mismatch("map", tag);
+    }
+}
+
+// notes, both of str and bin are accepted
+inline bool Unpacker::ReadStr(std::string_view* str) {
+    std::uint8_t tag = 0;
+    if (!ReadByte(&tag)) return false;
+
+    std::size_t n = 0;
+    if (tag >= 0xa0 && tag <= 0xbf) {
+        n = tag & 0x1f;
+    } else {
+        bool ok = false;
+        switch (tag) {
+            case 0xc4:
+            case 0xd9:
+                ok = ReadLength<std::uint8_t>(&n);
+                break;
+            case 0xc5:
+            case 0xda:
+                ok = ReadLength<std::uint16_t>(&n);
+                break;
+            case 0xc6:
+            case 0xdb:
+                ok = ReadLength<std::uint32_t>(&n);
+                break;
+            default:
+                return Mismatch("str", tag);
+        }
+        if (!ok) return false;
+    }
+
+    const char* p = nullptr;
+    if (!Take(n, &p)) return false;
+
+    *str = std::string_view(p, n);
+    return true;
+}
+
+inline bool Unpacker::ReadExt(std::int8_t* type, std::string_view* payload) {
+    std::uint8_t tag = 0;
+    if (!ReadByte(&tag)) return false;
+
+    std::size_t n = 0;
+    bool ok = true;
+    switch (tag) {
+        case 0xd4 ... 0xd8:
+            n = std::size_t{1} << (tag - 0xd4);
+            break;
+        case 0xc7:
+            ok = ReadLength<std::uint8_t>(&n);
+            break;
+        case 0xc8:
+            ok = ReadLength<std::uint16_t>(&n);
+            break;
+        case 0xc9:
+            ok = ReadLength<std::uint32_t>(&n);
+            break;
+        default:
+            return Mismatch("ext", tag);
+    }
+
+    const char* p = nullptr;
+    if (!ok || !ReadBigEndian(type) || !Take(n, &p)) return false;
+
+    *payload = std::string_view(p, n);
+    return true;
+}
+
+template <typename T>
+inline bool Unpacker::ReadInt(T* v) {
+    std::uint8_t tag = 0;
+    if (!ReadByte(&tag)) return false;
+
+    if (tag <= 0x7f) {
+        return AssignInt(v, tag);
+    } else if (tag >= 0xe0) {
+        return AssignInt(v, static_cast<std::int8_t>(tag));
+    }
+
+    switch (tag) {
+        case 0xcc:
+            return ReadIntAs<std::uint8_t>(v);
+        case 0xcd:
+            return ReadIntAs<std::uint16_t>(v);
+        case 0xce:
+            return ReadIntAs<std::uint32_t>(v);
+        case 0xcf:
+            return ReadIntAs<std::uint64_t>(v);
+        case 0xd0:
+            return ReadIntAs<std::int8_t>(v);
+        case 0xd1:
+            return ReadIntAs<std::int16_t>(v);
+        case 0xd2:
+            return ReadIntAs<std::int32_t>(v);
+        case 0xd3:
+            return ReadIntAs<std::int64_t>(v);
+        default:
+            return Mismatch("int", tag);
+    }
+}
+
+// notes, the integer is also accepted as a float
+template <typename T>
+inline bool Unpacker::ReadFloat(T* v) {
+    auto tag = Peek();
+    if (tag == 0xca || tag == 0xcb) {
+        ++cursor_;
+        if (tag == 0xca) {
+            float f;
+            if (!ReadBigEndian(&f)) return false;
+            *v = f;
+        } else {
+            double d;
+            if (!ReadBigEndian(&d)) return false;
+            *v = static_cast<T>(d);
+        }
+        return true;
+    }
+
+    if (tag == 0xcf) {
+        std::uint64_t u = 0;
+        if (!ReadInt(&u)) return false;
+        *v = static_cast<T>(u);
+    } else {
+        std::int64_t i = 0;
+        if (!ReadInt(&i)) return false;
+        *v = static_cast<T>(i);
+    }
+    return true;
+}
+
+// skips the next value, including the nested ones, without recursion
+inline bool Unpacker::Skip() {
+    std::size_t pending = 1;
+    while (pending > 0) {
+        --pending;
+
+        std::uint8_t tag = 0;
+        if (!ReadByte(&tag)) return false;
+
+        std::size_t n = 0;
+        const char* p = nullptr;
+        if (tag <= 0x7f || tag >= 0xe0) {
+            continue;
+        } else if (tag <= 0x8f) {
+            pending += 2 * (tag & 0x0f);
+            continue;
+        } else if (tag <= 0x9f) {
+            pending += tag & 0x0f;
+            continue;
+        } else if (tag <= 0xbf) {
+            if (!Take(tag & 0x1f, &p)) return false;
+            continue;
+        }
+
+        bool ok = true;
+        switch (tag) {
+            case 0xc0:
+            case 0xc2:
+            case 0xc3:
+                break;
+            case 0xcc:
+            case 0xd0:
+                ok = Take(1, &p);
+                break;
+            case 0xcd:
+            case 0xd1:
+                ok = Take(2, &p);
+                break;
+            case 0xca:
+            case 0xce:
+            case 0xd2:
+                ok = Take(4, &p);
+                break;
+            case 0xcb:
+            case 0xcf:
+            case 0xd3:
+                ok = Take(8, &p);
+                break;
+            case 0xc4:
+            case 0xd9:
+                ok = ReadLength<std::uint8_t>(&n) && Take(n, &p);
+                break;
+            case 0xc5:
+            case 0xda:
+                ok = ReadLength<std::uint16_t>(&n) && Take(n, &p);
+                break;
+            case 0xc6:
+            case 0xdb:
+                ok = ReadLength<std::uint32_t>(&n) && Take(n, &p);
+                break;
+            case 0xd4 ... 0xd8:
+                ok = Take(1 + (std::size_t{1} << (tag - 0xd4)), &p);
+                break;
+            case 0xc7:
+                ok = ReadLength<std::uint8_t>(&n) && Take(n + 1, &p);
+                break;
+            case 0xc8:
+                ok = ReadLength<std::uint16_t>(&n) && Take(n + 1, &p);
+                break;
+            case 0xc9:
+                ok = ReadLength<std::uint32_t>(&n) && Take(n + 1, &p);
+                break;
+            case 0xdc:
+                ok = ReadLength<std::uint16_t>(&n);
+                pending += n;
+                break;
+            case 0xdd:
+                ok = ReadLength<std::uint32_t>(&n);
+                pending += n;
+                break;
+            case 0xde:
+                ok = ReadLength<std::uint16_t>(&n);
+                pending += 2 * n;
+                break;
+            case 0xdf:
+                ok = ReadLength<std::uint32_t>(&n);
+                pending += 2 * n;
+                break;
+            default:
+                return E(kErrorParseFailure, "unknown tag {:#04x}", tag);
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+}  // namespace _
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromMsgPack(std::string_view data, T& value,
+                            std::string* detail_emsg = nullptr) {
+    _::Unpacker u(data);
+
+    _::ParseItem(u, value);
+    if (!u.IsError() && !u.IsEof()) {
+        u.E(kErrorParseFailure, "unexpected trailing bytes");
+    }
+
+    if (detail_emsg && u.IsError()) {
+        *detail_emsg = u.detail_error();
+    }
+
+    return u.error();
+}
+
+}  // namespace msgpack
+}  // namespace reflpp
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <byte_order.h>
+#include <field_name.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace reflpp {
+namespace msgpack {
+
+// the encoding of the aggregate struct, either a map keyed by the field names
+// or an array ordered by the field indices, which is smaller but requires both
+// of sides have the same field order
+enum Encoding {
+    kMap,
+    kArray,
+};
+
+namespace _ {
+
+// notes, the typed arrays are application-specific ext types. the type code is
+// `kExtTypedArray | kind`, and the payload is the little-endian elements
+inline constexpr std::int8_t kExtTypedArray = 0x10;
+
+template <typename T>
+inline constexpr bool IsTypedArrayElement =
+    IsIntegral<T> || std::is_same_v<std::decay_t<T>, float> ||
+    std::is_same_v<std::decay_t<T>, double>;
+
+template <typename T>
+constexpr std::int8_t TypedArrayExtType() {
+    static_assert(IsTypedArrayElement<T>, "Only numeric types are supported");
+
+    if constexpr (IsFloat<T>) {
+        return kExtTypedArray | (sizeof(T) == 4 ? 0x08 : 0x09);
+    } else {
+        constexpr std::int8_t kind = sizeof(T) == 1   ? 0
+                                     : sizeof(T) == 2 ? 2
+                                     : sizeof(T) == 4 ? 4
+                                                      : 6;
+        return kExtTypedArray | (kind + (std::is_unsigned_v<T> ? 1 : 0));
+    }
+}
+
+template <typename T, typename = void>
+struct IsTypedArrayImpl : std::false_type {};
+
+template <typename T>
+struct IsTypedArrayImpl<
+    T, std::enable_if_t<IsTemplateOf<std::vector, T> || IsNonCharArray<T>>>
+    : std::bool_constant<IsTypedArrayElement<
+          std::remove_cvref_t<decltype(*std::begin(std::declval<T&>()))>>> {};
+
+// the contiguous numeric arrays, e.g. std::vector<int> and std::array<float, N>
+template <typename T>
+inline constexpr bool IsTypedArray = IsTypedArrayImpl<RemoveCVRef<T>>::value;
+
+// Packer is the stream with the encoding options
+template <typename Stream, Encoding E = kMap, bool TypedArray = false>
+class Packer : public Stream {
+   public:
+    using value_type = typename Stream::value_type;
+    using size_type = typename Stream::size_type;
+
+    static constexpr Encoding kEncoding = E;
+    static constexpr bool kTypedArray = TypedArray;
+
+    Packer() = default;
+    Packer(size_type init_cap) { Stream::reserve(init_cap); }
+
+    Packer(Packer&&) = default;
+    Packer(const Packer&) = delete;
+    Packer& operator=(Packer&&) = default;
+    Packer& operator=(const Packer&) = delete;
+
+    Stream& stream() { return *this; }
+    const Stream& stream() const { return *this; }
+};
+
+template <typename Stream>
+inline void PutByte(Stream& s, std::uint8_t b) {
+    s.push_back(static_cast<char>(b));
+}
+
+template <typename Stream, typename T>
+inline void PutTagged(Stream& s, std::uint8_t tag, T v) {
+    char buf[1 + sizeof(T)];
+    buf[0] = static_cast<char>(tag);
+    StoreBigEndian(buf + 1, v);
+    s.append(buf, sizeof(buf));
+}
+
+// the tags of the 8-bit, 16-bit and 32-bit length, in order. notes, the 8-bit
+// length is absent for array and map
+template <typename Stream>
+inline void PutHeader(Stream& s, std::uint8_t fix_tag, std::size_t fix_limit,
+                      const std::uint8_t (&tags)[3], std::size_t n) {
+    if (n < fix_limit) {
+        PutByte(s, fix_tag | static_cast<std::uint8_t>(n));
+    } else if (tags[0] != 0 && n <= std::numeric_limits<std::uint8_t>::max()) {
+        PutTagged(s, tags[0], static_cast<std::uint8_t>(n));
+    } else if (n <= std::numeric_limits<std::uint16_t>::max()) {
+        PutTagged(s, tags[1], static_cast<std::uint16_t>(n));
+    } else {
+        PutTagged(s, tags[2], static_cast<std::uint32_t>(n));
+    }
+}
+
+template <typename Stream>
+inline void PutStrHeader(Stream& s, std::size_t n) {
+    PutHeader(s, 0xa0, 32, {0xd9, 0xda, 0xdb}, n);
+}
+
+template <typename Stream>
+inline void PutArrayHeader(Stream& s, std::size_t n) {
+    PutHeader(s, 0x90, 16, {0, 0xdc, 0xdd}, n);
+}
+
+template <typename Stream>
+inline void PutMapHeader(Stream& s, std::size_t n) {
+    PutHeader(s, 0x80, 16, {0, 0xde, 0xdf}, n);
+}
+
+template <typename Stream>
+inline void PutStr(Stream& s, std::string_view str) {
+    PutStrHeader(s, str.size());
+    s.append(str.data(), str.size());
+}
+
+template <typename Stream>
+inline void PutExtHeader(Stream& s, std::int8_t type, std::size_t n) {
+    switch (n) {
+        case 1:
+            PutByte(s, 0xd4);
+            break;
+        case 2:
+            PutByte(s, 0xd5);
+            break;
+        case 4:
+            PutByte(s, 0xd6);
+            break;
+        case 8:
+            PutByte(s, 0xd7);
+            break;
+        case 16:
+            PutByte(s, 0xd8);
+            break;
+        default:
+            PutHeader(s, 0, 0, {0xc7, 0xc8, 0xc9}, n);
+            break;
+    }
+    PutByte(s, static_cast<std::uint8_t>(type));
+}
+
+template <typename Stream, typename It>
+inline void PutTypedArray(Stream& s, It first, std::size_t n) {
+    using U = std::remove_cvref_t<decltype(*first)>;
+
+    PutExtHeader(s, TypedArrayExtType<U>(), n * sizeof(U));
+    // notes, the empty container has no element to take the address of
+    if (n == 0) return;
+
+    if constexpr (std::endian::native == std::endian::little) {
+        s.append(reinterpret_cast<const char*>(std::addressof(*first)),
+                 n * sizeof(U));
+    } else {
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            char buf[sizeof(U)];
+            StoreLittleEndian(buf, *first);
+            s.append(buf, sizeof(buf));
+        }
+    }
+}
+
+}  // namespace _
+
+template <typename Stream, typename T>
+inline void FormatMsgPackValue(Stream& s, const std::optional<T>&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsMapContainer<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSequenceContainer<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSetContainer<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsNonCharArray<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsCharArray<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T&);
+
+template <typename Stream>
+inline void FormatMsgPackValue(Stream& s, std::nullptr_t) {
+    _::PutByte(s, 0xc0);
+}
+
+template <typename Stream>
+inline void FormatMsgPackValue(Stream& s, bool b) {
+    _::PutByte(s, b ? 0xc3 : 0xc2);
+}
+
+template <typename Stream>
+inline void FormatMsgPackValue(Stream& s, char value) {
+    _::PutStr(s, std::string_view(&value, 1));
+}
+
+// notes, the integer is encoded in the smallest format which keeps the value
+template <typename Stream, typename T, std::enable_if_t<IsIntegral<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, T value) {
+    if constexpr (std::is_signed_v<T>) {
+        if (value < 0) {
+            if (value >= -32) {
+                _::PutByte(s, static_cast<std::uint8_t>(value));
+            } else if (value >= std::numeric_limits<std::int8_t>::min()) {
+                _::PutTagged(s, 0xd0, static_cast<std::int8_t>(value));
+            } else if (value >= std::numeric_limits<std::int16_t>::min()) {
+                _::PutTagged(s, 0xd1, static_cast<std::int16_t>(value));
+            } else if (value >= std::numeric_limits<std::int32_t>::min()) {
+                _::PutTagged(s, 0xd2, static_cast<std::int32_t>(value));
+            } else {
+                _::PutTagged(s, 0xd3, static_cast<std::int64_t>(value));
+            }
+            return;
+        }
+    }
+
+    auto u = static_cast<std::uint64_t>(value);
+    if (u <= 0x7f) {
+        _::PutByte(s, static_cast<std::uint8_t>(u));
+    } else if (u <= std::numeric_limits<std::uint8_t>::max()) {
+        _::PutTagged(s, 0xcc, static_cast<std::uint8_t>(u));
+    } else if (u <= std::numeric_limits<std::uint16_t>::max()) {
+        _::PutTagged(s, 0xcd, static_cast<std::uint16_t>(u));
+    } else if (u <= std::numeric_limits<std::uint32_t>::max()) {
+        _::PutTagged(s, 0xce, static_cast<std::uint32_t>(u));
+    } else {
+        _::PutTagged(s, 0xcf, u);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsFloat<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, T value) {
+    if constexpr (std::is_same_v<T, float>) {
+        _::PutTagged(s, 0xca, value);
+    } else {
+        _::PutTagged(s, 0xcb, static_cast<double>(value));
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsStringLike<T>, int> = 0>
+inline void FormatMsgPackValue(Stream& s, const T& t) {
+    _::PutStrHeader(s, t.size());
+    s.append(t.data(), t.size());
+}
+
+template <typename Stream, typename T>
+inline void FormatMsgPackValue(Stream& s, const std::optional<T>& val) {
+    if (!val) {
+        _::PutByte(s, 0xc0);
+    } else {
+        FormatMsgPackValue(s, *val);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsNonCharArray<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& v) {
+    constexpr std::size_t n = sizeof(T) / sizeof(v[0]);
+    if constexpr (Stream::kTypedArray && _::IsTypedArray<T>) {
+        _::PutTypedArray(s, std::begin(v), n);
+    } else {
+        _::PutArrayHeader(s, n);
+        for (const auto& e : v) {
+            FormatMsgPackValue(s, e);
+        }
+    }
+}
+
+// notes, the char array is handled as a string, which ends with '\0'
+template <typename Stream, typename T, std::enable_if_t<IsCharArray<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& v) {
+    constexpr std::size_t n = sizeof(T) / sizeof(v[0]);
+    std::size_t len = 0;
+    while (len < n && v[len] != '\0') {
+        ++len;
+    }
+    _::PutStr(s, std::string_view(std::begin(v), len));
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsMapContainer<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& v) {
+    _::PutMapHeader(s, v.size());
+    for (const auto& [key, val] : v) {
+        FormatMsgPackValue(s, key);
+        FormatMsgPackValue(s, val);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsSetContainer<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& v) {
+    _::PutArrayHeader(s, v.size());
+    for (const auto& e : v) {
+        FormatMsgPackValue(s, e);
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsSequenceContainer<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& v) {
+    if constexpr (Stream::kTypedArray && _::IsTypedArray<T>) {
+        _::PutTypedArray(s, v.begin(), v.size());
+    } else {
+        _::PutArrayHeader(s, v.size());
+        for (const auto& e : v) {
+            FormatMsgPackValue(s, e);
+        }
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsSmartPtr<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& v) {
+    if (v) {
+        FormatMsgPackValue(s, *v);
+    } else {
+        _::PutByte(s, 0xc0);
+    }
+}
+
+template <typename Stream, typename T, std::enable_if_t<IsTuple<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& t) {
+    _::PutArrayHeader(s, std::tuple_size_v<std::decay_t<T>>);
+    ForEach(t, [&s](auto, const auto& v) { FormatMsgPackValue(s, v); });
+}
+
+// notes, same as json, only the value of the variant is encoded
+template <typename Stream, typename T, std::enable_if_t<IsVariant<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& t) {
+    std::visit([&s](const auto& value) { FormatMsgPackValue(s, value); }, t);
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int>>
+inline void FormatMsgPackValue(Stream& s, const T& t) {
+    constexpr auto& fields = ::reflpp::kFieldNames<T>;
+
+    if constexpr (Stream::kEncoding == kMap) {
+        _::PutMapHeader(s, fields.size());
+        ForEach(t, [&](auto idx, const auto& v) {
+            _::PutStr(s, fields[idx]);
+            FormatMsgPackValue(s, v);
+        });
+    } else {
+        _::PutArrayHeader(s, fields.size());
+        ForEach(t, [&](auto, const auto& v) { FormatMsgPackValue(s, v); });
+    }
+}
+
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToMsgPack(Stream& s, const T& t) {
+    FormatMsgPackValue(s, t);
+}
+
+using MapPacker = _::Packer<std::string, kMap, false>;
+using ArrayPacker = _::Packer<std::string, kArray, false>;
+
+// the contiguous numeric arrays are copied as a whole into the typed array ext
+template <Encoding E>
+using TypedArrayPacker = _::Packer<std::string, E, true>;
+
+}  // namespace msgpack
+}  // namespace reflpp
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+#define PROTOBUF_ERROR_LIST(__)                           \
+    __(kOk, "OK")                                         \
+    __(kErrorUnexpectedTerminate, "Unexpected terminate") \
+    __(kErrorParseFailure, "Parse failure")               \
+    __(kErrorMismatchType, "Mismatch type")
+
+namespace reflpp {
+namespace protobuf {
+
+// clang-format off
+enum ErrorCode {
+#define __(A, B) A,
+    PROTOBUF_ERROR_LIST(__)
+#undef __
+};
+// clang-format on
+
+struct ProtobufErrorCategory : public std::error_category {
+    const char* name() const noexcept override { return "protobuf error"; }
+
+    // clang-format off
+    std::string message(int ec) const override {
+        switch (ec) {
+#define __(A, B) case A: return B;
+        PROTOBUF_ERROR_LIST(__)
+#undef __
+        }
+        return "unknown error code";
+    }
+    // clang-format on
+};
+
+inline const ProtobufErrorCategory error_category;
+
+inline std::error_code make_error(int ec) { return {ec, error_category}; }
+
+}  // namespace protobuf
+}  // namespace reflpp
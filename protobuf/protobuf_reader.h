@@ -0,0 +1,433 @@
+#pragma once
+
+#include <byte_order.h>
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <for_each.h>
+#include <protobuf/ec.h>
+#include <protobuf/protobuf_writer.h>
+#include <type_trait.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace reflpp {
+namespace protobuf {
+
+namespace _ {
+
+inline const char* WireTypeString(std::uint8_t wire) {
+    switch (wire) {
+        case kWireVarint:
+            return "varint";
+        case kWireFixed64:
+            return "i64";
+        case kWireLen:
+            return "len";
+        case kWireFixed32:
+            return "i32";
+        default:
+            return "group";
+    }
+}
+
+// notes, the nested message is decoded in place, whose end is limited by the
+// length prefix
+struct Decoder {
+    Decoder(std::string_view data) : data_(data), limit_(data.size()) {}
+
+    Decoder(Decoder&&) = default;
+    Decoder& operator=(Decoder&&) = default;
+
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
+
+    // notes, only the first error is kept
+    bool E(int ec) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = error_category.message(ec);
+        }
+        return false;
+    }
+
+    template <typename... Args>
+    bool E(int ec, const char* fmt, const Args&... args) {
+        if (!ec_) {
+            ec_ = make_error(ec);
+            detail_emsg_ = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        return false;
+    }
+
+    bool IsEof() const { return cursor_ >= limit_; }
+    bool IsError() const { return static_cast<bool>(ec_); }
+
+    std::error_code error() const { return ec_; }
+    std::string_view detail_error() const { return detail_emsg_; }
+
+    bool Take(std::size_t n, const char** p) {
+        if (IsError()) return false;
+
+        if (limit_ - cursor_ < n) {
+            return E(kErrorUnexpectedTerminate);
+        }
+
+        *p = data_.data() + cursor_;
+        cursor_ += n;
+        return true;
+    }
+
+    bool ReadVarint(std::uint64_t* v) {
+        // the fast path of the single byte
+        if (cursor_ < limit_ && !(data_[cursor_] & 0x80)) {
+            *v = static_cast<std::uint8_t>(data_[cursor_++]);
+            return true;
+        }
+
+        std::uint64_t n = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const char* p = nullptr;
+            if (!Take(1, &p)) return false;
+
+            auto b = static_cast<std::uint8_t>(*p);
+            n |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                *v = n;
+                return true;
+            }
+        }
+        return E(kErrorParseFailure, "invalid varint");
+    }
+
+    template <typename T>
+    bool ReadFixed(T* v) {
+        const char* p = nullptr;
+        if (!Take(sizeof(T), &p)) return false;
+
+        *v = LoadLittleEndian<T>(p);
+        return true;
+    }
+
+    bool ReadBytes(std::string_view* bytes) {
+        std::uint64_t n = 0;
+        const char* p = nullptr;
+        if (!ReadVarint(&n)) return false;
+        if (n > limit_ - cursor_) return E(kErrorUnexpectedTerminate);
+        if (!Take(n, &p)) return false;
+
+        *bytes = std::string_view(p, n);
+        return true;
+    }
+
+    // limits the decoder to the length-delimited body, and returns the old
+    // limit, which should be restored by PopLimit
+    bool PushLimit(std::size_t* old) {
+        std::uint64_t n = 0;
+        if (!ReadVarint(&n)) return false;
+        if (n > limit_ - cursor_) return E(kErrorUnexpectedTerminate);
+
+        *old = limit_;
+        limit_ = cursor_ + n;
+        return true;
+    }
+
+    void PopLimit(std::size_t old) {
+        if (!IsError() && cursor_ != limit_) {
+            E(kErrorParseFailure, "truncated length-delimited field");
+        }
+        limit_ = old;
+    }
+
+    bool Skip(std::uint8_t wire) {
+        std::uint64_t n = 0;
+        const char* p = nullptr;
+        switch (wire) {
+            case kWireVarint:
+                return ReadVarint(&n);
+            case kWireFixed64:
+                return Take(8, &p);
+            case kWireFixed32:
+                return Take(4, &p);
+            case kWireLen:
+                if (!ReadVarint(&n)) return false;
+                if (n > limit_ - cursor_) return E(kErrorUnexpectedTerminate);
+                return Take(n, &p);
+            default:
+                // notes, the deprecated groups aren't supported
+                return E(kErrorParseFailure, "unsupported wire type {}", wire);
+        }
+    }
+
+    bool Mismatch(std::uint8_t expect, std::uint8_t wire) {
+        return E(kErrorMismatchType, "expect `{}` but got `{}`",
+                 WireTypeString(expect), WireTypeString(wire));
+    }
+
+    std::error_code ec_;
+    std::string detail_emsg_;
+
+    std::size_t cursor_{0};
+    std::string_view data_;
+    std::size_t limit_;
+};
+
+// the field numbers in ascending order, which map to the field indices
+template <typename T>
+consteval auto GetSortedNumbers() {
+    constexpr auto& options = kFieldOptions<T>;
+    constexpr std::size_t N = options.size();
+
+    std::array<std::pair<std::uint32_t, std::size_t>, N> numbers{};
+    for (std::size_t i = 0; i < N; ++i) {
+        numbers[i] = {options[i].number, i};
+    }
+    std::sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+template <typename T>
+inline constexpr auto kSortedNumbers = GetSortedNumbers<T>();
+
+inline constexpr std::size_t kUnknownField = static_cast<std::size_t>(-1);
+
+// returns the index of the field number. notes, the fields are expected to be
+// in order, so the next field is checked at first
+template <typename T>
+inline std::size_t FindField(std::uint32_t number, std::size_t hint) {
+    constexpr auto& options = kFieldOptions<T>;
+    constexpr auto& numbers = kSortedNumbers<T>;
+
+    if (hint < options.size() && options[hint].number == number) {
+        return hint;
+    }
+
+    auto itr = std::lower_bound(
+        numbers.begin(), numbers.end(), number,
+        [](const auto& lhs, std::uint32_t rhs) { return lhs.first < rhs; });
+    if (itr == numbers.end() || itr->first != number) {
+        return kUnknownField;
+    }
+    return itr->second;
+}
+
+template <typename T>
+void ParseMessage(Decoder& d, T& value);
+
+template <typename T>
+void ParseScalar(Decoder& d, std::uint8_t wire, IntEncoding encoding,
+                 T& value) {
+    const auto expect = GetWireType<T>(encoding);
+    if (wire != expect) {
+        d.Mismatch(expect, wire);
+        return;
+    }
+
+    if constexpr (IsFloat<T>) {
+        if constexpr (std::is_same_v<T, float>) {
+            d.ReadFixed(&value);
+        } else {
+            double v = 0;
+            if (d.ReadFixed(&v)) value = static_cast<T>(v);
+        }
+    } else if (wire != kWireVarint) {
+        using U = std::conditional_t<(sizeof(T) <= 4), std::uint32_t,
+                                     std::uint64_t>;
+        U v = 0;
+        if (d.ReadFixed(&v)) value = static_cast<T>(v);
+    } else {
+        std::uint64_t v = 0;
+        if (!d.ReadVarint(&v)) return;
+
+        // notes, the integer is truncated, the same as protobuf
+        if constexpr (IsBool<T>) {
+            value = v != 0;
+        } else if constexpr (IsEnum<T>) {
+            value = static_cast<T>(v);
+        } else if constexpr (std::is_signed_v<T>) {
+            value = static_cast<T>(encoding == kZigzag
+                                       ? ZigzagDecode(v)
+                                       : static_cast<std::int64_t>(v));
+        } else {
+            value = static_cast<T>(v);
+        }
+    }
+}
+
+// parses one element of the field, which may occur multiple times
+template <typename T>
+void ParseValue(Decoder& d, std::uint8_t wire, IntEncoding encoding,
+                T& value) {
+    if constexpr (IsScalar<T>) {
+        ParseScalar(d, wire, encoding, value);
+    } else if (wire != kWireLen) {
+        d.Mismatch(kWireLen, wire);
+    } else if constexpr (IsBytes<T>) {
+        // notes, the string view refers to the input buffer
+        std::string_view bytes;
+        if (!d.ReadBytes(&bytes)) return;
+
+        if constexpr (IsStringView<T>) {
+            value = bytes;
+        } else {
+            using U = typename T::value_type;
+            auto p = reinterpret_cast<const U*>(bytes.data());
+            value.assign(p, p + bytes.size());
+        }
+    } else if constexpr (IsPair<T>) {
+        using K = RemoveCVRef<typename T::first_type>;
+
+        std::size_t old = 0;
+        if (!d.PushLimit(&old)) return;
+        while (!d.IsEof() && !d.IsError()) {
+            std::uint64_t tag = 0;
+            if (!d.ReadVarint(&tag)) break;
+
+            std::uint8_t w = tag & 0x7;
+            if ((tag >> 3) == 1) {
+                ParseValue(d, w, kVarint, const_cast<K&>(value.first));
+            } else if ((tag >> 3) == 2) {
+                ParseValue(d, w, kVarint, value.second);
+            } else {
+                d.Skip(w);
+            }
+        }
+        d.PopLimit(old);
+    } else {
+        static_assert(IsAggregateStruct<T>, "Unsupported type");
+
+        std::size_t old = 0;
+        if (!d.PushLimit(&old)) return;
+        ParseMessage(d, value);
+        d.PopLimit(old);
+    }
+}
+
+template <typename T>
+void ParseField(Decoder& d, std::uint8_t wire, IntEncoding encoding,
+                T& value) {
+    if constexpr (IsOptional<T>) {
+        // notes, the message is merged, the same as protobuf
+        if (!value) value.emplace();
+        ParseValue(d, wire, encoding, *value);
+    } else if constexpr (IsSmartPtr<T>) {
+        using V = typename T::element_type;
+        if (!value) {
+            if constexpr (IsUniquePtr<T>) {
+                value = std::make_unique<V>();
+            } else {
+                value = std::make_shared<V>();
+            }
+        }
+        ParseValue(d, wire, encoding, *value);
+    } else if constexpr (IsMapContainer<T>) {
+        std::pair<typename T::key_type, typename T::mapped_type> entry{};
+        ParseValue(d, wire, encoding, entry);
+        if (!d.IsError()) {
+            value[std::move(entry.first)] = std::move(entry.second);
+        }
+    } else if constexpr (IsRepeated<T>) {
+        using E = typename T::value_type;
+
+        auto add = [&value](E&& e) {
+            if constexpr (IsSequenceContainer<T>) {
+                value.push_back(std::move(e));
+            } else {
+                value.insert(std::move(e));
+            }
+        };
+
+        // the packed scalars, and the unpacked ones are also accepted
+        if constexpr (IsScalar<E>) {
+            if (wire == kWireLen) {
+                std::size_t old = 0;
+                if (!d.PushLimit(&old)) return;
+
+                const auto w = GetWireType<E>(encoding);
+                while (!d.IsEof() && !d.IsError()) {
+                    E e{};
+                    ParseScalar(d, w, encoding, e);
+                    add(std::move(e));
+                }
+                d.PopLimit(old);
+                return;
+            }
+        }
+
+        E e{};
+        ParseValue(d, wire, encoding, e);
+        add(std::move(e));
+    } else {
+        ParseValue(d, wire, encoding, value);
+    }
+}
+
+template <typename T>
+using FieldParser = void (*)(Decoder&, std::uint8_t, T&);
+
+template <std::size_t I, typename T>
+void ParseFieldAt(Decoder& d, std::uint8_t wire, T& value) {
+    ParseField(d, wire, kFieldOptions<T>[I].encoding, GetField<I>(value));
+}
+
+template <typename T, std::size_t... Is>
+consteval auto GetFieldParsersImpl(std::index_sequence<Is...>) {
+    return std::array<FieldParser<T>, sizeof...(Is)>{&ParseFieldAt<Is, T>...};
+}
+
+// the parsers of fields, which are indexed by the field index, so that the
+// field is parsed without visiting the others
+template <typename T>
+inline constexpr auto kFieldParsers =
+    GetFieldParsersImpl<T>(std::make_index_sequence<FieldsCount<T>()>{});
+
+template <typename T>
+void ParseMessage(Decoder& d, T& value) {
+    static_assert(IsValidFieldOptions<T>(), "Invalid field numbers");
+
+    std::size_t hint = 0;
+    while (!d.IsEof() && !d.IsError()) {
+        std::uint64_t tag = 0;
+        if (!d.ReadVarint(&tag)) return;
+
+        std::uint8_t wire = tag & 0x7;
+        if ((tag >> 3) == 0 || (tag >> 3) > kMaxFieldNumber) {
+            d.E(kErrorParseFailure, "invalid field number {}", tag >> 3);
+            return;
+        }
+
+        // for compatibility, here skip unknown fields
+        auto idx = FindField<T>(tag >> 3, hint);
+        if (idx == kUnknownField) {
+            d.Skip(wire);
+            continue;
+        }
+
+        hint = idx + 1;
+        kFieldParsers<T>[idx](d, wire, value);
+    }
+}
+
+}  // namespace _
+
+template <typename T, std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+std::error_code FromProtobuf(std::string_view data, T& value,
+                             std::string* detail_emsg = nullptr) {
+    _::Decoder d(data);
+    _::ParseMessage(d, value);
+
+    if (detail_emsg && d.IsError()) {
+        *detail_emsg = d.detail_error();
+    }
+
+    return d.error();
+}
+
+}  // namespace protobuf
+}  // namespace reflpp
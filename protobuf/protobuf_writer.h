@@ -0,0 +1,328 @@
+#pragma once
+
+#include <byte_order.h>
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace reflpp {
+namespace protobuf {
+
+// the wire encoding of the integer field, see the scalar value types of
+// protobuf. notes, kVarint is int32/int64/uint32/uint64, kZigzag is
+// sint32/sint64, and kFixed is fixed32/fixed64/sfixed32/sfixed64
+enum IntEncoding {
+    kVarint,
+    kZigzag,
+    kFixed,
+};
+
+struct FieldOptions {
+    std::uint32_t number{0};
+    IntEncoding encoding{kVarint};
+};
+
+// by default, the field number is the field index plus one. specializes it to
+// override the field numbers and the integer encodings, e.g.,
+//
+//   template <>
+//   struct ProtobufFields<Foo> {
+//       static constexpr std::array<FieldOptions, 2> value{{
+//           {1},
+//           {5, kZigzag},
+//       }};
+//   };
+template <typename T>
+struct ProtobufFields {};
+
+namespace _ {
+
+enum WireType : std::uint8_t {
+    kWireVarint = 0,
+    kWireFixed64 = 1,
+    kWireLen = 2,
+    kWireStartGroup = 3,
+    kWireEndGroup = 4,
+    kWireFixed32 = 5,
+};
+
+inline constexpr std::uint32_t kMaxFieldNumber = (1u << 29) - 1;
+
+template <typename T>
+inline constexpr bool IsScalar =
+    IsBool<T> || IsNumeric<T> || IsEnum<T> || IsChar<T>;
+
+// the string and bytes are length-delimited as is
+template <typename T>
+inline constexpr bool IsBytes = IsStringLike<T> || IsByteVector<T>;
+
+template <typename T>
+inline constexpr bool IsRepeated =
+    (IsSequenceContainer<T> || IsSetContainer<T>) && !IsByteVector<T>;
+
+template <typename T, typename = void>
+struct HasFieldOptions : std::false_type {};
+
+template <typename T>
+struct HasFieldOptions<T, std::void_t<decltype(ProtobufFields<T>::value)>>
+    : std::true_type {};
+
+template <typename T>
+consteval auto GetFieldOptions() {
+    constexpr std::size_t N = FieldsCount<T>();
+
+    if constexpr (HasFieldOptions<T>::value) {
+        static_assert(ProtobufFields<T>::value.size() == N,
+                      "The count of field options mismatch");
+        return ProtobufFields<T>::value;
+    } else {
+        std::array<FieldOptions, N> options{};
+        for (std::size_t i = 0; i < N; ++i) {
+            options[i].number = i + 1;
+        }
+        return options;
+    }
+}
+
+template <typename T>
+inline constexpr auto kFieldOptions = GetFieldOptions<T>();
+
+template <typename T>
+consteval bool IsValidFieldOptions() {
+    constexpr auto& options = kFieldOptions<T>;
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        if (options[i].number == 0 || options[i].number > kMaxFieldNumber) {
+            return false;
+        }
+        for (std::size_t j = 0; j < i; ++j) {
+            if (options[i].number == options[j].number) return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+constexpr WireType GetWireType(IntEncoding encoding) {
+    using U = RemoveCVRef<T>;
+
+    if constexpr (std::is_same_v<U, float>) {
+        return kWireFixed32;
+    } else if constexpr (IsFloat<U>) {
+        return kWireFixed64;
+    } else if constexpr (IsBool<U> || IsEnum<U>) {
+        return kWireVarint;
+    } else if constexpr (IsScalar<U>) {
+        if (encoding != kFixed) return kWireVarint;
+        return sizeof(U) <= 4 ? kWireFixed32 : kWireFixed64;
+    } else {
+        return kWireLen;
+    }
+}
+
+inline constexpr std::uint64_t ZigzagEncode(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^
+           static_cast<std::uint64_t>(v >> 63);
+}
+
+inline constexpr std::int64_t ZigzagDecode(std::uint64_t v) {
+    return static_cast<std::int64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+template <typename Stream>
+inline void PutVarint(Stream& s, std::uint64_t n) {
+    char buf[10];
+    std::size_t len = 0;
+    while (n >= 0x80) {
+        buf[len++] = static_cast<char>(n | 0x80);
+        n >>= 7;
+    }
+    buf[len++] = static_cast<char>(n);
+    s.append(buf, len);
+}
+
+inline constexpr std::size_t VarintSize(std::uint64_t n) {
+    std::size_t len = 1;
+    for (; n >= 0x80; n >>= 7) ++len;
+    return len;
+}
+
+template <typename Stream>
+inline void PutTag(Stream& s, std::uint32_t number, WireType wire) {
+    PutVarint(s, (static_cast<std::uint64_t>(number) << 3) | wire);
+}
+
+// notes, the negative int32 is sign-extended to 10 bytes, which is the same
+// as protobuf
+template <typename Stream, typename T>
+inline void PutScalar(Stream& s, T v, IntEncoding encoding) {
+    if constexpr (IsBool<T>) {
+        PutVarint(s, v ? 1 : 0);
+    } else if constexpr (IsFloat<T>) {
+        char buf[sizeof(T)];
+        StoreLittleEndian(buf, v);
+        s.append(buf, sizeof(buf));
+    } else if constexpr (IsEnum<T>) {
+        PutScalar(s, static_cast<std::underlying_type_t<T>>(v), kVarint);
+    } else if (encoding == kFixed) {
+        using U = std::conditional_t<(sizeof(T) <= 4), std::uint32_t,
+                                     std::uint64_t>;
+        using S = std::make_signed_t<U>;
+        using I = std::conditional_t<std::is_signed_v<T>, S, U>;
+
+        char buf[sizeof(U)];
+        StoreLittleEndian(buf, static_cast<U>(static_cast<I>(v)));
+        s.append(buf, sizeof(buf));
+    } else if constexpr (std::is_signed_v<T>) {
+        auto i = static_cast<std::int64_t>(v);
+        PutVarint(s, encoding == kZigzag ? ZigzagEncode(i)
+                                         : static_cast<std::uint64_t>(i));
+    } else {
+        PutVarint(s, static_cast<std::uint64_t>(v));
+    }
+}
+
+template <typename Stream, typename T>
+inline void FormatMessage(Stream& s, const T& t);
+
+// the message is written in two passes, since the length prefix of the
+// delimited body is ahead of it. the first pass only counts the bytes, and
+// records the lengths of the bodies in the order they start, which are
+// written forward by the second pass
+struct Sizer {
+    std::size_t bytes{0};
+    std::vector<std::size_t> lengths;
+
+    void append(const char*, std::size_t n) { bytes += n; }
+};
+
+template <typename Stream>
+struct LengthWriter {
+    Stream& s;
+    const std::size_t* lengths;
+
+    void append(const char* p, std::size_t n) { s.append(p, n); }
+};
+
+// writes the length-delimited body, which is produced by the function with
+// the stream of the pass
+template <typename F>
+inline void PutDelimited(Sizer& s, std::uint32_t number, F&& f) {
+    PutTag(s, number, kWireLen);
+
+    auto slot = s.lengths.size();
+    s.lengths.push_back(0);
+
+    auto start = s.bytes;
+    f(s);
+    auto len = s.bytes - start;
+    s.lengths[slot] = len;
+    s.bytes += VarintSize(len);
+}
+
+template <typename Stream, typename F>
+inline void PutDelimited(LengthWriter<Stream>& s, std::uint32_t number,
+                         F&& f) {
+    PutTag(s, number, kWireLen);
+    PutVarint(s, *s.lengths++);
+    f(s);
+}
+
+// writes the field even if it's the default value
+template <typename Stream, typename T>
+inline void PutField(Stream& s, const FieldOptions& opt, const T& v) {
+    if constexpr (IsScalar<T>) {
+        PutTag(s, opt.number, GetWireType<T>(opt.encoding));
+        PutScalar(s, v, opt.encoding);
+    } else if constexpr (IsBytes<T>) {
+        PutTag(s, opt.number, kWireLen);
+        PutVarint(s, v.size());
+        s.append(reinterpret_cast<const char*>(v.data()), v.size());
+    } else if constexpr (IsPair<T>) {
+        // the map entry, whose key is 1 and value is 2
+        PutDelimited(s, opt.number, [&v](auto& out) {
+            PutField(out, FieldOptions{1}, v.first);
+            PutField(out, FieldOptions{2}, v.second);
+        });
+    } else {
+        static_assert(IsAggregateStruct<T>, "Unsupported type");
+        PutDelimited(s, opt.number, [&v](auto& out) { FormatMessage(out, v); });
+    }
+}
+
+// notes, the scalar field with the default value is omitted, the same as
+// proto3, unless it's optional
+template <typename Stream, typename T>
+inline void FormatField(Stream& s, const FieldOptions& opt, const T& v) {
+    if constexpr (IsScalar<T>) {
+        bool keep = v != T{};
+        if constexpr (IsFloat<T>) {
+            // notes, -0.0 isn't the default value, which is kept
+            keep = keep || std::signbit(v);
+        }
+        if (keep) {
+            PutField(s, opt, v);
+        }
+    } else if constexpr (IsBytes<T>) {
+        if (!v.empty()) {
+            PutField(s, opt, v);
+        }
+    } else if constexpr (IsOptional<T> || IsSmartPtr<T>) {
+        if (v) {
+            PutField(s, opt, *v);
+        }
+    } else if constexpr (IsRepeated<T> || IsMapContainer<T>) {
+        using E = typename T::value_type;
+
+        if constexpr (IsScalar<E>) {
+            // the repeated scalars are packed
+            if (v.empty()) return;
+            PutDelimited(s, opt.number, [&v, &opt](auto& out) {
+                for (const auto& e : v) {
+                    PutScalar(out, e, opt.encoding);
+                }
+            });
+        } else {
+            for (const auto& e : v) {
+                PutField(s, opt, e);
+            }
+        }
+    } else {
+        PutField(s, opt, v);
+    }
+}
+
+template <typename Stream, typename T>
+inline void FormatMessage(Stream& s, const T& t) {
+    static_assert(IsValidFieldOptions<T>(), "Invalid field numbers");
+
+    constexpr auto& options = kFieldOptions<T>;
+    ForEach(t, [&s](auto idx, const auto& v) {
+        FormatField(s, options[idx], v);
+    });
+}
+
+}  // namespace _
+
+// writes the struct as the protobuf message, the stream should support
+// appending, e.g., std::string
+template <typename Stream, typename T,
+          std::enable_if_t<IsAggregateStruct<T>, int> _ = 0>
+inline void ToProtobuf(Stream& s, const T& t) {
+    _::Sizer sizer;
+    _::FormatMessage(sizer, t);
+
+    _::LengthWriter<Stream> writer{s, sizer.lengths.data()};
+    _::FormatMessage(writer, t);
+}
+
+}  // namespace protobuf
+}  // namespace reflpp
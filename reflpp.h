@@ -1,12 +1,47 @@
 #pragma once
 
+#include <aggregate.h>
+#include <arrow/arrow_writer.h>
+#include <binary/binary_reader.h>
+#include <binary/binary_writer.h>
+#include <binary/ec.h>
+#include <byte_order.h>
+#include <cbor/cbor_reader.h>
+#include <cbor/cbor_writer.h>
+#include <cbor/ec.h>
+#include <compare.h>
+#include <csv/csv_reader.h>
+#include <csv/csv_writer.h>
+#include <csv/ec.h>
+#include <deep_size.h>
+#include <diff.h>
+#include <field_access.h>
 #include <field_name.h>
+#include <field_path.h>
 #include <fields_count.h>
+#include <fingerprint.h>
+#include <flat/ec.h>
+#include <flat/flat_view.h>
+#include <flat/flat_writer.h>
 #include <for_each.h>
+#include <generate.h>
+#include <hash.h>
 #include <json/ec.h>
+#include <json/fixed_buffer.h>
 #include <json/json_reader.h>
 #include <json/json_value.h>
 #include <json/json_writer.h>
+#include <json/parallel_writer.h>
 #include <json/pretty_formatter.h>
+#include <json/tracked_writer.h>
+#include <layout.h>
+#include <msgpack/ec.h>
+#include <msgpack/msgpack_reader.h>
+#include <msgpack/msgpack_writer.h>
+#include <protobuf/ec.h>
+#include <protobuf/protobuf_reader.h>
+#include <protobuf/protobuf_writer.h>
+#include <soa_vector.h>
+#include <tracked.h>
 #include <utils.h>
 #include <value.h>
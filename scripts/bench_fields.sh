@@ -0,0 +1,151 @@
+#!/bin/bash
+
+# measures the compile time and the peak memory of the wide structs, e.g.,
+#   scripts/bench_fields.sh             # 32, 64, 128 and 256 fields
+#   scripts/bench_fields.sh 64 128
+#
+# "light" covers ForEach, GetField<I> and FieldType<I> for every I, plus
+# kFieldNames, and "full" adds the json and binary round trips through
+# reflpp.h. "tuple" is the last revision which binds the fields as the
+# std::tuple, whose bindings are extended to the fields, and "new" is the
+# working tree. notes, fmt should be built by scripts/build_deps.sh
+
+set -e
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O1}
+FIELDS=${*:-32 64 128 256}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# the parent of the revision which introduced the flat pack of fields
+TUPLE_REV=${TUPLE_REV:-$(git -C "$ROOT" log -S IndexedPack --format=%H \
+    --reverse -- for_each.h | head -1)^}
+
+function gen_macros() {
+    local n=$1
+
+    echo -n "#define REFLPP_FOR_EACH_CNT(MACRO)"
+    for ((i = 1; i <= n; i++)); do
+        echo -n " MACRO($i)"
+    done
+    echo
+
+    local names=""
+    for ((i = 1; i <= n; i++)); do
+        names+="${names:+, }a$i"
+        echo "#define REFLPP_UNPACK_FIELDS_$i $names"
+    done
+}
+
+# the tuple revision only binds 32 fields, so that the macros are replaced
+function prepare_tuple() {
+    local max=$1
+
+    mkdir -p "$WORK/tuple"
+    git -C "$ROOT" archive "$TUPLE_REV" | tar -x -C "$WORK/tuple"
+
+    gen_macros "$max" > "$WORK/tuple/tuple_macros.h"
+    sed -i -e '/^#define REFLPP_FOR_EACH_CNT/,/MACRO(32)$/d' \
+        -e '/^#define REFLPP_UNPACK_FIELDS_/d' \
+        -e 's/^#include <tuple>$/#include <tuple>\n#include <tuple_macros.h>/' \
+        "$WORK/tuple/for_each.h"
+}
+
+function gen_source() {
+    local n=$1
+    local full=$2
+
+    if [ "$full" = 1 ]; then
+        echo "#include <reflpp.h>"
+    else
+        echo "#include <field_name.h>"
+        echo "#include <for_each.h>"
+    fi
+    echo "#include <cstddef>"
+    echo "#include <string>"
+    echo "#include <utility>"
+
+    echo "struct Wide {"
+    for ((i = 1; i <= n; i++)); do
+        echo "    int f$i;"
+    done
+    echo "};"
+
+    cat <<EOF
+template <std::size_t... Is>
+int Touch(Wide& w, std::index_sequence<Is...>) {
+    int sum = 0;
+    ::reflpp::ForEach(w, [&sum](auto, const auto& v) { sum += v; });
+    ((sum += ::reflpp::GetField<Is>(w) +
+             sizeof(::reflpp::FieldType<Is, Wide>)),
+     ...);
+    for (auto name : ::reflpp::kFieldNames<Wide>) {
+        sum += name.size();
+    }
+    return sum;
+}
+
+int main() {
+    Wide w{}, w1{};
+    int sum = Touch(w, std::make_index_sequence<$n>{});
+EOF
+    if [ "$full" = 1 ]; then
+        cat <<EOF
+    ::reflpp::json::CompactJsonFormatter json;
+    ::reflpp::json::ToJson(json, w);
+    sum += ::reflpp::json::FromJson(json, w1).value();
+
+    std::string buf;
+    ::reflpp::binary::ToBinary(buf, w);
+    sum += ::reflpp::binary::FromBinary(buf, w1).value();
+EOF
+    fi
+    echo "    return sum;"
+    echo "}"
+}
+
+# prints the seconds and the peak memory in MB of the compilation
+function measure() {
+    python3 - "$@" <<'EOF'
+import resource
+import subprocess
+import sys
+import time
+
+start = time.monotonic()
+subprocess.run(sys.argv[1:], check=True)
+elapsed = time.monotonic() - start
+peak = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss // 1024
+print(f"{elapsed:5.2f}s {peak:4d}MB", end="")
+EOF
+}
+
+function compile() {
+    local tree=$1
+    local n=$2
+    local full=$3
+
+    local src="$WORK/wide_${n}_${full}.cc"
+    gen_source "$n" "$full" > "$src"
+    measure "$CXX" -std=c++20 $CXXFLAGS -I "$tree" \
+        -I "$ROOT/third-party/fmt/build/include" -c "$src" -o /dev/null
+}
+
+max=0
+for n in $FIELDS; do
+    if ((n > max)); then
+        max=$n
+    fi
+done
+prepare_tuple "$max"
+
+printf "%-8s %-16s %-16s %-16s %s\n" fields "light (tuple)" \
+    "light (new)" "full (tuple)" "full (new)"
+for n in $FIELDS; do
+    printf "%-8s %-16s %-16s %-16s %s\n" "$n" \
+        "$(compile "$WORK/tuple" "$n" 0)" "$(compile "$ROOT" "$n" 0)" \
+        "$(compile "$WORK/tuple" "$n" 1)" "$(compile "$ROOT" "$n" 1)"
+done
@@ -0,0 +1,20 @@
+#include <layout.h>
+
+#include <iostream>
+#include <string>
+
+// prints the layouts of the types in REFLPP_LAYOUT_TYPES, which are declared
+// in REFLPP_LAYOUT_HEADER, see the layout-report target in Makefile
+#include REFLPP_LAYOUT_HEADER
+
+template <typename... Ts>
+void Report() {
+    std::string s;
+    ((reflpp::FormatLayoutReport<Ts>(s), s.push_back('\n')), ...);
+    std::cout << s;
+}
+
+int main() {
+    Report<REFLPP_LAYOUT_TYPES>();
+    return 0;
+}
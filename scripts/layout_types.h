@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// the types reported by `make layout-report` by default, see Makefile
+namespace layout_types {
+
+struct Order {
+    char side;
+    std::int64_t id;
+    double price;
+    std::int32_t qty;
+};
+
+struct Tick {
+    std::int64_t ts;
+    double bid;
+    double ask;
+    std::int32_t bid_size;
+    std::int32_t ask_size;
+};
+
+struct Record {
+    bool active;
+    std::string name;
+    std::uint16_t flags;
+    std::vector<double> samples;
+    std::optional<std::int32_t> parent;
+    std::uint8_t level;
+};
+
+}  // namespace layout_types
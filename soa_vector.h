@@ -0,0 +1,404 @@
+#pragma once
+
+#include <fields_count.h>
+#include <for_each.h>
+#include <type_trait.h>
+#include <utils.h>
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace reflpp {
+
+// SoaVector stores the rows of the aggregate struct as columns, i.e., each
+// field is in its own contiguous array, so that the scan over a few fields
+// only touches their columns. the rows are accessed through the proxy
+// references, and the columns are accessed as spans
+template <typename T>
+class SoaVector {
+    static_assert(IsAggregateStruct<T>,
+                  "Only the aggregate struct is supported");
+
+   public:
+    static constexpr std::size_t kFieldsCount = FieldsCount<T>();
+
+    template <std::size_t I>
+    using ColumnType = std::remove_const_t<FieldType<I, T>>;
+
+    template <bool Const>
+    class Reference;
+
+    template <bool Const>
+    class Iterator;
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference<false>;
+    using const_reference = Reference<true>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    SoaVector() = default;
+
+    SoaVector(SoaVector&& other) noexcept
+        : columns_(std::move(other.columns_)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    SoaVector(const SoaVector& other) {
+        Reallocate(other.size_);
+        ForEachIndex([this, &other](auto idx) {
+            constexpr std::size_t I = decltype(idx)::value;
+            const auto* src = std::get<I>(other.columns_).get();
+            std::copy(src, src + other.size_, std::get<I>(columns_).get());
+        });
+        size_ = other.size_;
+    }
+
+    SoaVector& operator=(SoaVector&& other) noexcept {
+        columns_ = std::move(other.columns_);
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        return *this;
+    }
+
+    SoaVector& operator=(const SoaVector& other) {
+        if (this != &other) {
+            *this = SoaVector(other);
+        }
+        return *this;
+    }
+
+   public:
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    // allocates all of columns at once
+    void reserve(std::size_t n) {
+        if (n > capacity_) {
+            Reallocate(n);
+        }
+    }
+
+    // notes, the new rows are value-initialized, and the removed rows are
+    // reset to release their resources, e.g., strings
+    void resize(std::size_t n) {
+        reserve(n);
+        ForEachIndex([this, n](auto idx) {
+            constexpr std::size_t I = decltype(idx)::value;
+            auto* column = std::get<I>(columns_).get();
+            if (n > size_) {
+                std::fill(column + size_, column + n, ColumnType<I>{});
+            } else {
+                std::fill(column + n, column + size_, ColumnType<I>{});
+            }
+        });
+        size_ = n;
+    }
+
+    void clear() { resize(0); }
+
+    void push_back(const T& v) {
+        Grow();
+        Store(size_++, v);
+    }
+
+    void push_back(T&& v) {
+        Grow();
+        Store(size_++, std::move(v));
+    }
+
+    // appends the value-initialized row
+    reference emplace_back() {
+        Grow();
+        Store(size_, T{});
+        return reference(this, size_++);
+    }
+
+    void pop_back() {
+        REFLPP_ASSERT(size_ > 0);
+        Store(--size_, T{});
+    }
+
+   public:
+    reference operator[](std::size_t i) { return reference(this, i); }
+    const_reference operator[](std::size_t i) const {
+        return const_reference(this, i);
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+
+    reference back() { return (*this)[size_ - 1]; }
+    const_reference back() const { return (*this)[size_ - 1]; }
+
+    // the I-th field of the i-th row
+    template <std::size_t I>
+    ColumnType<I>& Get(std::size_t i) {
+        return std::get<I>(columns_)[i];
+    }
+
+    template <std::size_t I>
+    const ColumnType<I>& Get(std::size_t i) const {
+        return std::get<I>(columns_)[i];
+    }
+
+    // the I-th field of all of rows
+    template <std::size_t I>
+    std::span<ColumnType<I>> Column() {
+        return {std::get<I>(columns_).get(), size_};
+    }
+
+    template <std::size_t I>
+    std::span<const ColumnType<I>> Column() const {
+        return {std::get<I>(columns_).get(), size_};
+    }
+
+    // gathers the fields of the row
+    T Load(std::size_t i) const {
+        T v{};
+        ForEachIndex([this, i, &v](auto idx) {
+            constexpr std::size_t I = decltype(idx)::value;
+            GetField<I>(v) = std::get<I>(columns_)[i];
+        });
+        return v;
+    }
+
+    // scatters the fields to the row
+    template <typename V,
+              std::enable_if_t<std::is_same_v<RemoveCVRef<V>, T>, int> = 0>
+    void Store(std::size_t i, V&& v) {
+        ForEachIndex([this, i, &v](auto idx) {
+            constexpr std::size_t I = decltype(idx)::value;
+            if constexpr (std::is_lvalue_reference_v<V>) {
+                std::get<I>(columns_)[i] = GetField<I>(v);
+            } else {
+                std::get<I>(columns_)[i] = std::move(GetField<I>(v));
+            }
+        });
+    }
+
+   public:
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    iterator end() { return iterator(this, size_); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+   private:
+    template <std::size_t... Is>
+    static auto MakeColumns(std::index_sequence<Is...>)
+        -> std::tuple<std::unique_ptr<ColumnType<Is>[]>...>;
+
+    using Columns = decltype(MakeColumns(
+        std::make_index_sequence<kFieldsCount>{}));
+
+    template <typename F, std::size_t... Is>
+    static void ForEachIndexImpl(F&& f, std::index_sequence<Is...>) {
+        (f(std::integral_constant<std::size_t, Is>{}), ...);
+    }
+
+    template <typename F>
+    static void ForEachIndex(F&& f) {
+        ForEachIndexImpl(f, std::make_index_sequence<kFieldsCount>{});
+    }
+
+    void Grow() {
+        if (size_ == capacity_) {
+            Reallocate(std::max<std::size_t>(8, capacity_ * 2));
+        }
+    }
+
+    // notes, the slots beyond the size are default-initialized, which are
+    // assigned before use
+    void Reallocate(std::size_t n) {
+        Columns columns;
+        ForEachIndex([this, n, &columns](auto idx) {
+            constexpr std::size_t I = decltype(idx)::value;
+            auto& column = std::get<I>(columns);
+            column = std::make_unique_for_overwrite<ColumnType<I>[]>(n);
+
+            auto* src = std::get<I>(columns_).get();
+            std::move(src, src + size_, column.get());
+        });
+        columns_ = std::move(columns);
+        capacity_ = n;
+    }
+
+    Columns columns_;
+    std::size_t size_{0};
+    std::size_t capacity_{0};
+};
+
+// the proxy reference to the row
+template <typename T>
+template <bool Const>
+class SoaVector<T>::Reference {
+   public:
+    using Owner = std::conditional_t<Const, const SoaVector, SoaVector>;
+
+    Reference(Owner* owner, std::size_t idx) : owner_(owner), idx_(idx) {}
+
+    Reference(const Reference&) = default;
+
+    // the const reference is converted from the mutable one
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    Reference(const Reference<false>& other)
+        : owner_(other.owner_), idx_(other.idx_) {}
+
+    // notes, the assignment writes through the reference, the same as
+    // std::vector<bool>::reference
+    Reference& operator=(const Reference& other) {
+        static_assert(!Const, "The const reference is read-only");
+        owner_->Store(idx_, other.Load());
+        return *this;
+    }
+
+    Reference& operator=(const T& v) {
+        static_assert(!Const, "The const reference is read-only");
+        owner_->Store(idx_, v);
+        return *this;
+    }
+
+    Reference& operator=(T&& v) {
+        static_assert(!Const, "The const reference is read-only");
+        owner_->Store(idx_, std::move(v));
+        return *this;
+    }
+
+   public:
+    template <std::size_t I>
+    auto& Get() const {
+        return owner_->template Get<I>(idx_);
+    }
+
+    T Load() const { return owner_->Load(idx_); }
+    operator T() const { return Load(); }
+
+    std::size_t index() const { return idx_; }
+
+    // swaps the rows column by column, e.g., for std::sort, which swaps the
+    // proxies returned by the iterators
+    friend void swap(Reference a, Reference b) { a.Swap(b); }
+
+   private:
+    friend class Reference<!Const>;
+
+    void Swap(const Reference& other) const {
+        static_assert(!Const, "The const reference is read-only");
+        SoaVector::ForEachIndex([this, &other](auto idx) {
+            constexpr std::size_t I = decltype(idx)::value;
+            using std::swap;
+            swap(this->template Get<I>(), other.template Get<I>());
+        });
+    }
+
+    Owner* owner_;
+    std::size_t idx_;
+};
+
+template <typename T>
+template <bool Const>
+class SoaVector<T>::Iterator {
+   public:
+    using Owner = std::conditional_t<Const, const SoaVector, SoaVector>;
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference<Const>;
+    using pointer = void;
+
+    Iterator() = default;
+    Iterator(Owner* owner, std::size_t idx) : owner_(owner), idx_(idx) {}
+
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    Iterator(const Iterator<false>& other)
+        : owner_(other.owner_), idx_(other.idx_) {}
+
+   public:
+    reference operator*() const { return reference(owner_, idx_); }
+    reference operator[](difference_type n) const {
+        return reference(owner_, idx_ + n);
+    }
+
+    Iterator& operator++() {
+        ++idx_;
+        return *this;
+    }
+
+    Iterator operator++(int) {
+        auto it = *this;
+        ++idx_;
+        return it;
+    }
+
+    Iterator& operator--() {
+        --idx_;
+        return *this;
+    }
+
+    Iterator operator--(int) {
+        auto it = *this;
+        --idx_;
+        return it;
+    }
+
+    Iterator& operator+=(difference_type n) {
+        idx_ += n;
+        return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+        idx_ -= n;
+        return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+        return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) {
+        return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+        return static_cast<difference_type>(a.idx_) -
+               static_cast<difference_type>(b.idx_);
+    }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) {
+        return a.idx_ == b.idx_;
+    }
+
+    friend auto operator<=>(const Iterator& a, const Iterator& b) {
+        return a.idx_ <=> b.idx_;
+    }
+
+   private:
+    friend class Iterator<!Const>;
+
+    Owner* owner_{nullptr};
+    std::size_t idx_{0};
+};
+
+template <typename T>
+inline constexpr bool IsSoaVector = IsTemplateOf<SoaVector, RemoveCVRef<T>>;
+
+}  // namespace reflpp
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <field_name.h>
+#include <fields_count.h>
+#include <for_each.h>
+
+#include <array>
+#include <bitset>
+#include <string>
+#include <utility>
+
+namespace reflpp {
+
+// Tracked wraps an aggregate struct and records which fields are modified
+// through the setters. the writers, e.g. json::ToJson, cache the serialized
+// fragment of each field, and only re-encode the dirty fields next time
+template <typename T>
+class Tracked {
+   public:
+    static constexpr std::size_t kFieldsCount = FieldsCount<T>();
+
+    // the serialized fragments of fields, which are maintained by the writer.
+    // the tag identifies the writer which produces the fragments
+    struct FragmentCache {
+        const void* tag{nullptr};
+        std::array<std::string, kFieldsCount> fragments;
+    };
+
+    Tracked() { MarkAllDirty(); }
+    explicit Tracked(T value) : value_(std::move(value)) { MarkAllDirty(); }
+
+    Tracked(Tracked&&) = default;
+    Tracked(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    Tracked& operator=(const Tracked&) = default;
+
+   public:
+    const T& value() const { return value_; }
+
+    // notes, the whole object is considered dirty
+    T& MutableValue() {
+        MarkAllDirty();
+        return value_;
+    }
+
+    template <std::size_t I>
+    const auto& Get() const {
+        return GetField<I>(value_);
+    }
+
+    template <std::size_t I, typename V>
+    void Set(V&& v) {
+        GetField<I>(value_) = std::forward<V>(v);
+        dirty_.set(I);
+    }
+
+    // notes, the field is marked dirty even though it is not modified
+    template <std::size_t I>
+    auto& Mutable() {
+        dirty_.set(I);
+        return GetField<I>(value_);
+    }
+
+   public:
+    bool IsDirty(std::size_t idx) const { return dirty_.test(idx); }
+    bool IsDirty() const { return dirty_.any(); }
+
+    void MarkDirty(std::size_t idx) { dirty_.set(idx); }
+    void MarkAllDirty() { dirty_.set(); }
+    void ClearDirty() { dirty_.reset(); }
+
+    FragmentCache& cache() { return cache_; }
+    const FragmentCache& cache() const { return cache_; }
+
+   private:
+    T value_{};
+    std::bitset<kFieldsCount> dirty_;
+    FragmentCache cache_;
+};
+
+template <typename T>
+inline constexpr bool IsTracked = IsTemplateOf<Tracked, RemoveCVRef<T>>;
+
+}  // namespace reflpp
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <iterator>
 #include <list>
 #include <map>
 #include <memory>
@@ -11,6 +14,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -62,6 +66,24 @@ struct IsSetContainerImpl
           bool, TemplateInstance<std::set, T>::value ||
                     TemplateInstance<std::unordered_set, T>::value> {};
 
+template <typename T>
+struct IsUnorderedContainerImpl
+    : std::integral_constant<
+          bool, TemplateInstance<std::unordered_map, T>::value ||
+                    TemplateInstance<std::unordered_set, T>::value ||
+                    TemplateInstance<std::unordered_multimap, T>::value ||
+                    TemplateInstance<std::unordered_multiset, T>::value> {};
+
+template <typename T, typename = void>
+struct IsContiguousContainerImpl : std::false_type {};
+
+template <typename T>
+struct IsContiguousContainerImpl<
+    T, std::void_t<decltype(std::declval<const T&>().data()),
+                   typename T::const_iterator>>
+    : std::bool_constant<
+          std::contiguous_iterator<typename T::const_iterator>> {};
+
 template <typename T, typename = void>
 struct IsArrayImpl : std::false_type {};
 
@@ -103,6 +125,9 @@ inline constexpr bool IsNumeric = IsIntegral<T> || IsFloat<T>;
 template <typename T>
 inline constexpr bool IsEnum = std::is_enum_v<T>;
 
+template <typename T>
+inline constexpr bool IsPair = IsTemplateOf<std::pair, RemoveCVRef<T>>;
+
 // Notes, we expect the tuple should not be empty
 template <typename T>
 inline constexpr bool IsTuple = IsTemplateOf<std::tuple, RemoveCVRef<T>>;
@@ -137,6 +162,16 @@ template <typename T>
 inline constexpr bool IsAssciativeContainer =
     _::IsAssciativeContainerImpl<RemoveCVRef<T>>::value;
 
+// the iteration order of the unordered container is unspecified
+template <typename T>
+inline constexpr bool IsUnorderedContainer =
+    _::IsUnorderedContainerImpl<RemoveCVRef<T>>::value;
+
+// the elements are stored contiguously, e.g., std::vector and std::string
+template <typename T>
+inline constexpr bool IsContiguousContainer =
+    _::IsContiguousContainerImpl<RemoveCVRef<T>>::value;
+
 template <typename T>
 inline constexpr bool IsVariant = IsTemplateOf<std::variant, RemoveCVRef<T>>;
 
@@ -184,6 +219,15 @@ struct IsNonCharArrayImpl<
            std::enable_if_t<!std::is_same_v<
                char, std::remove_reference_t<decltype(std::declval<T>()[0])>>>>>
     : std::true_type {};
+
+template <typename T>
+struct IsByteVectorImpl : std::false_type {};
+
+template <typename T, typename A>
+struct IsByteVectorImpl<std::vector<T, A>>
+    : std::bool_constant<std::is_same_v<T, char> ||
+                         std::is_same_v<T, std::uint8_t> ||
+                         std::is_same_v<T, std::byte>> {};
 }  // namespace _
 
 template <typename T>
@@ -192,6 +236,11 @@ inline constexpr bool IsCharArray = _::IsCharArrayImpl<T>::value;
 template <typename T>
 inline constexpr bool IsNonCharArray = _::IsNonCharArrayImpl<T>::value;
 
+// the byte vector is encoded as the byte string by the binary formats
+template <typename T>
+inline constexpr bool IsByteVector =
+    _::IsByteVectorImpl<RemoveCVRef<T>>::value;
+
 template <typename T>
 inline constexpr bool IsUniquePtr =
     IsTemplateOf<std::unique_ptr, RemoveCVRef<T>>;
@@ -203,4 +252,21 @@ inline constexpr bool IsSharedPtr =
 template <typename T>
 inline constexpr bool IsSmartPtr = IsUniquePtr<T> || IsSharedPtr<T>;
 
+namespace _ {
+template <typename T>
+struct ValueOfImpl {
+    using type = T;
+};
+
+template <typename T>
+struct ValueOfImpl<std::optional<T>> {
+    using type = T;
+};
+}  // namespace _
+
+// the value type of the optional, or the type itself, e.g., the value type of
+// the nullable column
+template <typename T>
+using ValueOf = typename _::ValueOfImpl<RemoveCVRef<T>>::type;
+
 }  // namespace reflpp
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <charconv>
+#include <cstddef>
 #include <optional>
 #include <string_view>
 #include <system_error>
@@ -17,6 +18,11 @@
 
 namespace reflpp {
 
+// rounds up to the multiple of the alignment
+constexpr std::size_t AlignUp(std::size_t n, std::size_t align) {
+    return (n + align - 1) / align * align;
+}
+
 template <typename T>
 std::error_code LexicalCast(std::string_view str, T& val) {
     auto res = std::from_chars(str.data(), str.data() + str.size(), val);